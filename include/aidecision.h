@@ -0,0 +1,22 @@
+#ifndef AIDECISION_H
+#define AIDECISION_H
+
+#include "gamestate.h"
+#include "player.h"
+#include <cstdint>
+
+// Seed streams shared by every match driver (Game, hearts-server,
+// hearts-sim). The match ID comes from stream 0 of the match seed and
+// round N is dealt from stream N. Built-in AI decisions derive from the
+// deal ID, so a seed plays out identically wherever it runs.
+std::uint32_t matchIdForSeed(std::uint64_t seed);
+std::uint64_t dealIdForRound(std::uint64_t seed, int round);
+
+// Built-in AI choices from a core position. `ai` supplies the difficulty
+// and card memory; its hand and game context are set from `state`.
+CardSet aiPassDecision(Player& ai, const GameState& state, const GameRules& rules,
+                       int roundNumber, std::uint64_t dealId, int seat);
+int aiPlayDecision(Player& ai, const GameState& state, const GameRules& rules,
+                   int roundNumber, std::uint64_t dealId, int ply);
+
+#endif // AIDECISION_H
@@ -0,0 +1,12 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstdint>
+
+// Heap allocations made by the calling thread so far. Only counted in debug
+// builds of targets that link the alloccounter object library (hearts-perft),
+// which replaces the global operator new; everywhere else it reports 0.
+// Used to assert that hot paths (simulateRound) stay off the heap.
+std::uint64_t heapAllocationCount();
+
+#endif // ALLOCCOUNTER_H
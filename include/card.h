@@ -4,6 +4,7 @@
 #include <QString>
 #include <QVector>
 #include <QHash>
+#include "cardset.h"
 
 enum class Suit { Clubs, Diamonds, Spades, Hearts };
 enum class Rank { Two = 2, Three, Four, Five, Six, Seven, Eight, Nine, Ten, Jack, Queen, King, Ace };
@@ -30,6 +31,10 @@ public:
     // Parse from element ID
     static Card fromElementId(const QString& id);
 
+    // Bit index in a CardSet (see cardset.h)
+    int index() const { return static_cast<int>(m_suit) * SUIT_SIZE + static_cast<int>(m_rank) - 2; }
+    static Card fromIndex(int index);
+
     // Display strings
     QString rankString() const;
     QString suitString() const;
@@ -69,4 +74,11 @@ Card highestBelow(const Cards& cards, Rank maxRank);  // Highest card below a gi
 Card lowestAbove(const Cards& cards, Rank minRank);   // Lowest card above a given rank
 int countSuit(const Cards& cards, Suit suit);
 
+// Conversion to and from the bitboard representation
+CardSet toCardSet(const Cards& cards);
+Cards fromCardSet(CardSet set);  // Sorted, like Player::sortHand()
+
+// Card::fromIndex(index).elementId(), built once for list models
+const QString& cardElementId(int index);
+
 #endif // CARD_H
@@ -0,0 +1,145 @@
+#ifndef CARDATLAS_H
+#define CARDATLAS_H
+
+#include "cardtheme.h"
+#include "perfmonitor.h"
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+class QQuickWindow;
+class QSGTexture;
+
+// All 52 card faces plus the back packed into one image per (size, DPR),
+// uploaded as one texture per window. Every card on the table samples a
+// sub-rect of the same texture, so the scene graph can batch them into a
+// handful of draw calls.
+//
+// Images are built on the theme's render pool, one card per worker, and
+// handed back to the GUI thread; textures are created and retired on the
+// render thread from updatePaintNode(). Items hold a reference on the size
+// they draw at, and only unreferenced atlases are dropped. Until a new size
+// is built, items keep drawing from the one they had; a build whose size
+// loses its last reference first (a window drag) is cancelled.
+class CardAtlas : public QObject {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Owned by gameBridge")
+
+public:
+    static const int BACK = CARD_COUNT;       // Slot of the card back
+    static const int SLOTS = CARD_COUNT + 1;
+    static const int COLUMNS = 8;
+    static const int PADDING = 2;             // Pixels between cells; stops linear filtering bleeding
+    static const int MAX_SIZES = 4;           // Unreferenced atlases beyond this are dropped
+
+    explicit CardAtlas(CardTheme* theme, QObject* parent = nullptr);
+
+    void setTheme(CardTheme* theme);
+    void setMonitor(PerfMonitor* monitor) { m_monitor = monitor; }
+
+    // Starts building the atlas for cards of `size` logical pixels at `dpr`
+    // if needed and takes a reference on it. Returns its key (0 for an empty
+    // size); built() is emitted once its image is ready. GUI thread.
+    quint64 acquire(const QSize& size, qreal dpr);
+    void release(quint64 key);
+    bool isReady(quint64 key) const;
+
+    // Texture of an acquired atlas in `window`, or null. Render thread.
+    QSGTexture* texture(QQuickWindow* window, quint64 key);
+
+    // Cell of `slot` (card index or BACK) in the texture, in texels
+    static QRect slotRect(quint64 key, int slot);
+
+    // Rebuild every referenced atlas (theme changed); the old images stay
+    // on screen until the new ones are ready
+    void invalidate();
+
+signals:
+    void built(quint64 key);
+
+private:
+    using CancelToken = std::shared_ptr<std::atomic<bool>>;
+
+    struct Atlas {
+        QImage image;                 // Null until the first build finishes
+        CancelToken build;            // Set while a build is queued or running
+        QSize size;
+        qreal dpr = 1.0;
+        QHash<QQuickWindow*, QSGTexture*> textures;
+        int refs = 0;
+        quint64 lastUse = 0;
+    };
+
+    // Key packs the cell size in device pixels
+    static quint64 keyOf(const QSize& size, qreal dpr);
+    static QSize cellSize(quint64 key);
+    void build(quint64 key, Atlas& atlas);
+    void cancelBuild(Atlas& atlas);
+    void finishBuild(quint64 key, const CancelToken& token, const QImage& image);
+    void trim();
+    void retire(Atlas& atlas);
+    void watchWindow(QQuickWindow* window);
+
+    CardTheme* m_theme;
+    PerfMonitor* m_monitor = nullptr;
+    QHash<quint64, Atlas> m_atlases;
+    QVector<QSGTexture*> m_retired;   // Deleted after the next sync, when no node uses them
+    QVector<QQuickWindow*> m_windows;
+    quint64 m_useCounter = 0;
+};
+
+// One card (face or back) drawn from the shared atlas by a QSGImageNode
+class CardImage : public QQuickItem {
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(CardAtlas* atlas READ atlas WRITE setAtlas NOTIFY atlasChanged)
+    Q_PROPERTY(int suit READ suit WRITE setSuit NOTIFY cardChanged)
+    Q_PROPERTY(int rank READ rank WRITE setRank NOTIFY cardChanged)
+    Q_PROPERTY(bool faceUp READ faceUp WRITE setFaceUp NOTIFY cardChanged)
+
+public:
+    explicit CardImage(QQuickItem* parent = nullptr);
+    ~CardImage();
+
+    CardAtlas* atlas() const { return m_atlas; }
+    void setAtlas(CardAtlas* atlas);
+    int suit() const { return m_suit; }
+    void setSuit(int suit);
+    int rank() const { return m_rank; }
+    void setRank(int rank);
+    bool faceUp() const { return m_faceUp; }
+    void setFaceUp(bool faceUp);
+
+signals:
+    void atlasChanged();
+    void cardChanged();
+
+protected:
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData& data) override;
+    void updatePolish() override;
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+
+    // This card's texture and texel rect; render thread, null until polished
+    QSGTexture* atlasTexture() const;
+    QRect atlasRect() const;
+
+private:
+    int slot() const;
+    void refresh();
+
+    CardAtlas* m_atlas = nullptr;
+    quint64 m_key = 0;          // Atlas size drawn by this item
+    quint64 m_pendingKey = 0;   // Size it is waiting on, while that atlas builds
+    int m_suit = 0;
+    int m_rank = 2;
+    bool m_faceUp = true;
+};
+
+#endif // CARDATLAS_H
@@ -0,0 +1,19 @@
+#ifndef CARDCODES_H
+#define CARDCODES_H
+
+#include "gamestate.h"
+#include <string>
+#include <vector>
+
+// Two-character card codes used by the text protocols: rank then suit,
+// 2-9, T, J, Q, K, A and C, D, S, H (e.g. "QS", "TH", "2C").
+
+std::string cardCode(int card);
+int parseCardCode(const std::string& code);  // -1 if malformed
+std::string cardCodes(CardSet cards, char separator = ' ');  // Ascending
+char passDirectionCode(PassDirection dir);
+
+// Splits on spaces and tabs, dropping empty words and a trailing '\r'
+std::vector<std::string> splitWords(const std::string& line);
+
+#endif // CARDCODES_H
@@ -2,18 +2,25 @@
 #define CARDIMAGEPROVIDER_H
 
 #include "cardtheme.h"
-#include <QQuickImageProvider>
+#include "perfmonitor.h"
+#include <QQuickAsyncImageProvider>
 
-class CardImageProvider : public QQuickImageProvider {
+// Serves image://cards/<card>, image://cards/back and the opponent fan
+// sprites. Requests are answered from the theme's worker pool; CardTheme's
+// cache makes concurrent requests for one image share a single render.
+class CardImageProvider : public QQuickAsyncImageProvider {
 public:
-    CardImageProvider(CardTheme* theme);
+    CardImageProvider(CardTheme* theme, PerfMonitor* monitor = nullptr);
 
-    QPixmap requestPixmap(const QString& id, QSize* size, const QSize& requestedSize) override;
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
 
     void setTheme(CardTheme* theme) { m_theme = theme; }
 
 private:
+    static QImage renderImage(CardTheme* theme, const QString& id, const QSize& requestedSize, qreal dpr);
+
     CardTheme* m_theme;
+    PerfMonitor* m_monitor;
 };
 
 #endif // CARDIMAGEPROVIDER_H
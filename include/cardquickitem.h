@@ -0,0 +1,49 @@
+#ifndef CARDQUICKITEM_H
+#define CARDQUICKITEM_H
+
+#include "cardatlas.h"
+#include <QColor>
+
+// A whole table card as one scene-graph subtree: drop shadow, the face or
+// back from the card atlas, a tint overlay (dimming) and a highlight border,
+// all flat-colour or atlas-textured so neighbouring cards batch together.
+// Replaces the Image + Rectangle stack CardItem.qml used to build per card;
+// movement is left to Animators, which run on the render thread.
+class CardQuickItem : public CardImage {
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(QColor borderColor READ borderColor WRITE setBorderColor NOTIFY borderColorChanged)
+    Q_PROPERTY(QColor tintColor READ tintColor WRITE setTintColor NOTIFY tintColorChanged)
+    Q_PROPERTY(bool shadow READ shadow WRITE setShadow NOTIFY shadowChanged)
+
+public:
+    static constexpr qreal CORNER_RADIUS = 6;
+    static constexpr qreal BORDER_WIDTH = 2;
+    static constexpr qreal SHADOW_OFFSET = 1.5;
+
+    explicit CardQuickItem(QQuickItem* parent = nullptr);
+
+    QColor borderColor() const { return m_borderColor; }
+    void setBorderColor(const QColor& color);
+    QColor tintColor() const { return m_tintColor; }
+    void setTintColor(const QColor& color);
+    bool shadow() const { return m_shadow; }
+    void setShadow(bool shadow);
+
+signals:
+    void borderColorChanged();
+    void tintColorChanged();
+    void shadowChanged();
+
+protected:
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+
+private:
+    QColor m_borderColor = Qt::transparent;
+    QColor m_tintColor = Qt::transparent;
+    bool m_shadow = true;
+    bool m_geometryDirty = true;
+};
+
+#endif // CARDQUICKITEM_H
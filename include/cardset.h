@@ -0,0 +1,46 @@
+#ifndef CARDSET_H
+#define CARDSET_H
+
+#include <cstdint>
+
+// 52-bit card bitboard used by the rules core. Bit index is
+// suit * 13 + (rank - 2), with suits ordered as the Suit enum
+// (Clubs, Diamonds, Spades, Hearts), so iterating bits low to high
+// visits cards in the same order as sorting a hand.
+using CardSet = std::uint64_t;
+
+constexpr int CARD_COUNT = 52;
+constexpr int SUIT_SIZE = 13;
+constexpr int HEARTS_SUIT = 3;
+constexpr int TWO_OF_CLUBS = 0;
+constexpr int QUEEN_OF_SPADES = 2 * SUIT_SIZE + 10;
+
+constexpr CardSet cardBit(int card) { return CardSet(1) << card; }
+constexpr CardSet suitMask(int suit) { return ((CardSet(1) << SUIT_SIZE) - 1) << (suit * SUIT_SIZE); }
+constexpr int cardSuit(int card) { return card / SUIT_SIZE; }
+constexpr int cardRankIndex(int card) { return card % SUIT_SIZE; }  // 0 = Two, 12 = Ace
+
+constexpr CardSet ALL_CARDS = (CardSet(1) << CARD_COUNT) - 1;
+constexpr CardSet HEARTS_MASK = suitMask(HEARTS_SUIT);
+constexpr CardSet POINT_CARDS = HEARTS_MASK | cardBit(QUEEN_OF_SPADES);
+
+constexpr int cardPoints(int card) {
+    return card == QUEEN_OF_SPADES ? 13 : (cardSuit(card) == HEARTS_SUIT ? 1 : 0);
+}
+
+inline int cardCount(CardSet set) { return __builtin_popcountll(set); }
+
+// Index of the lowest card in a non-empty set
+inline int firstCard(CardSet set) { return __builtin_ctzll(set); }
+
+// Index of the highest card in a non-empty set
+inline int lastCard(CardSet set) { return 63 - __builtin_clzll(set); }
+
+// Removes and returns the lowest card of a non-empty set
+inline int popFirstCard(CardSet& set) {
+    int card = firstCard(set);
+    set &= set - 1;
+    return card;
+}
+
+#endif // CARDSET_H
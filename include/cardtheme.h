@@ -3,10 +3,16 @@
 
 #include "card.h"
 #include <QString>
-#include <QPixmap>
-#include <QSvgRenderer>
+#include <QImage>
+#include <QCache>
 #include <QHash>
-#include <memory>
+#include <QMutex>
+#include <QSet>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <functional>
+
+class QPainter;
 
 struct ThemeInfo {
     QString name;
@@ -14,8 +20,46 @@ struct ThemeInfo {
     QString svgFile;
 };
 
+// Identifies a cached image: a card face or back at a size, or an opponent
+// fan sprite of such cards
+struct CardImageKey {
+    int slot;           // Card index, CardTheme::BACK or CardTheme::FAN
+    int width;          // Card size in logical pixels
+    int height;
+    qreal dpr;
+    int count = 0;      // Fan sprites only
+    int rotation = 0;
+    int spacing = 0;
+};
+
+inline bool operator==(const CardImageKey& a, const CardImageKey& b) {
+    return a.slot == b.slot && a.width == b.width && a.height == b.height && a.dpr == b.dpr
+        && a.count == b.count && a.rotation == b.rotation && a.spacing == b.spacing;
+}
+
+inline size_t qHash(const CardImageKey& key, size_t seed = 0) {
+    return qHashMulti(seed, key.slot, key.width, key.height, key.dpr, key.count, key.rotation, key.spacing);
+}
+
+struct CardCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    qint64 bytes = 0;
+    qint64 budget = 0;
+    int images = 0;
+};
+
+// Card images for one theme. Loading happens on the GUI thread; rendering is
+// thread-safe and meant to run on renderPool(), where every worker keeps its
+// own QSvgRenderer (they are not thread-safe). Images are cached up to a
+// byte budget, least recently used first out, and concurrent misses for the
+// same image wait for a single render.
 class CardTheme {
 public:
+    static const int BACK = CARD_COUNT;   // Slot of the card back in cardImage()
+    static const int FAN = CARD_COUNT + 1;
+    static const qint64 DEFAULT_CACHE_BUDGET = 64 << 20;
+
     CardTheme();
 
     // Find available themes
@@ -25,27 +69,57 @@ public:
     bool loadTheme(const QString& path);
     void loadBuiltinTheme();
 
-    // Render cards
-    QPixmap cardFront(const Card& card, const QSize& size);
-    QPixmap cardBack(const QSize& size);
+    // Render cards: `size` in logical pixels, images carry `dpr`
+    QImage cardImage(int slot, const QSize& size, qreal dpr);
+    QImage cardFront(const Card& card, const QSize& size, qreal dpr) { return cardImage(card.index(), size, dpr); }
+    QImage cardBack(const QSize& size, qreal dpr) { return cardImage(BACK, size, dpr); }
+
+    // An opponent's face-down hand as one sprite: `count` backs of cardSize,
+    // `spacing` apart, each rotated by `rotation` degrees (90 west, 180
+    // north, -90 east) and laid out exactly like OpponentHand.qml's cards
+    QImage cardFan(int count, int rotation, const QSize& cardSize, int spacing, qreal dpr);
+    static QSize cardFanSize(int count, int rotation, const QSize& cardSize, int spacing);
+
+    // Workers for asynchronous rendering
+    QThreadPool* renderPool() { return &m_pool; }
 
     QString themeName() const { return m_themeName; }
     QString themePath() const { return m_themePath; }
     bool isLoaded() const { return m_loaded; }
-    void clearCache() { m_cache.clear(); }
+    void clearCache();
+
+    // Bytes of images kept; the least recently used go first when over
+    void setCacheBudget(qint64 bytes);
+    qint64 cacheBudget() const;
+    CardCacheStats cacheStats() const;
 
 private:
-    QPixmap renderSvgElement(const QString& elementId, const QSize& size);
-    QPixmap generateCard(const Card& card, const QSize& size);
-    QPixmap generateCardBack(const QSize& size);
-    void drawSuitSymbol(QPainter& painter, Suit suit, const QRectF& rect, const QColor& color);
+    // Returns the cached image for `key`, rendering it with `render` (given
+    // the theme's SVG path, empty for the built-in cards) on a miss
+    QImage cached(const CardImageKey& key, const std::function<QImage(const QString&)>& render);
+    void setSvgPath(const QString& svgPath);
+
+    static QImage renderSvgElement(const QString& svgPath, const QString& elementId, const QSize& size, qreal dpr);
+    static QImage generateCard(const Card& card, const QSize& size, qreal dpr);
+    static QImage generateCardBack(const QSize& size, qreal dpr);
+    static void drawSuitSymbol(QPainter& painter, Suit suit, const QRectF& rect, const QColor& color);
 
-    std::unique_ptr<QSvgRenderer> m_renderer;
     QString m_themeName;
     QString m_themePath;
     bool m_loaded;
     bool m_usingSvg;
-    mutable QHash<QString, QPixmap> m_cache;
+
+    // Shared with the render workers
+    mutable QMutex m_mutex;
+    QWaitCondition m_rendered;
+    QString m_svgPath;
+    quint64 m_generation = 0;        // Bumped on theme change; older renders aren't cached
+    QCache<CardImageKey, QImage> m_cache;   // Cost is the image's size in bytes
+    QSet<CardImageKey> m_rendering;  // Keys some thread is rendering right now
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+
+    QThreadPool m_pool;              // Last: joins the workers before the rest is destroyed
 };
 
 #endif // CARDTHEME_H
@@ -0,0 +1,46 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "gamestate.h"
+#include <QByteArray>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <array>
+
+// Everything needed to rebuild an unfinished match: the current round is
+// re-dealt from its deal ID and the logged moves are replayed on top.
+struct MatchCheckpoint {
+    quint64 seed = 0;                                 // Match seed; later rounds deal from it
+    quint32 matchId = 0;
+    GameRules rules;
+    int roundNumber = 0;
+    std::array<int, 4> totalScores = {0, 0, 0, 0};  // Totals at the start of the round
+    quint64 dealId = 0;
+    bool passed = false;                              // Pass exchange done this round
+    Hands passes = {0, 0, 0, 0};                      // Cards each seat passed
+    QVector<quint8> plays;                            // Card indices in play order
+
+    QByteArray serialize() const;
+    static bool deserialize(const QByteArray& data, MatchCheckpoint* out);
+};
+
+// Binary checkpoint file written atomically (temp file + rename) on a
+// background thread so the GUI never waits on disk.
+class CheckpointStore {
+public:
+    explicit CheckpointStore(const QString& path = defaultPath());
+    ~CheckpointStore();
+
+    static QString defaultPath();
+
+    void save(const MatchCheckpoint& checkpoint);
+    void clear();
+    bool load(MatchCheckpoint* out) const;
+
+private:
+    QString m_path;
+    QThreadPool m_writer;  // Single thread keeps writes in order
+};
+
+#endif // CHECKPOINT_H
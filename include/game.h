@@ -3,13 +3,16 @@
 
 #include "card.h"
 #include "player.h"
-#include "deck.h"
+#include "gamestate.h"
+#include "checkpoint.h"
+#include "gamerecord.h"
+#include "gameclock.h"
 #include <QObject>
 #include <memory>
 #include <array>
 #include <QStack>
 
-enum class GameState {
+enum class GamePhase {
     NotStarted,
     Dealing,
     Passing,
@@ -21,41 +24,41 @@ enum class GameState {
     GameOver
 };
 
-enum class PassDirection { Left, Right, Across, None };
-
-// Game rules configuration
-struct GameRules {
-    int endScore = 100;              // Game ends when a player reaches this score
-    bool exactResetTo50 = false;     // If score is exactly endScore, reset to 50
-    bool queenBreaksHearts = true;   // Q♠ breaks hearts when played (standard: true)
-    bool moonProtection = false;     // If +26 to others would cause shooter to lose, they can take -26 instead
-    bool fullPolish = false;         // 99 points + takes 25 = reset to 98
+// Everything one engine step changed, published as a single event so the
+// view refreshes once per step instead of once per field
+struct Transition {
+    enum Dirty : quint32 {
+        Phase        = 1 << 0,
+        Turn         = 1 << 1,
+        Hands        = 1 << 2,
+        Trick        = 1 << 3,
+        Scores       = 1 << 4,
+        CardPlayed   = 1 << 5,  // `player` played `card`
+        HeartsBroken = 1 << 6   // Hearts were broken by that card
+    };
 
-    // Default standard rules
-    static GameRules standard() {
-        return GameRules{100, false, true, false, false};
-    }
+    quint32 dirty = 0;
+    GamePhase phase = GamePhase::NotStarted;
+    int currentPlayer = 0;
+    int player = -1;
+    Card card;
 };
 
 // Snapshot of game state for undo functionality
 struct GameSnapshot {
-    GameState state;
+    GamePhase phase;
     int roundNumber;
     PassDirection passDirection;
-    int currentPlayer;
-    bool heartsBroken;
-    bool isFirstTrick;
-    Suit leadSuit;
-    Cards currentTrick;
-    QVector<int> trickPlayers;
-    // Player states
-    struct PlayerState {
-        Cards hand;
-        int roundScore;
-        int totalScore;
-        CardMemory cardMemory;  // AI card memory for proper undo
-    };
-    std::array<PlayerState, 4> playerStates;
+    GameState core;
+    std::array<CardMemory, 4> cardMemories;  // AI card memory for proper undo
+
+    // The round's checkpoint and record state; a snapshot may be from an
+    // earlier round than the one being undone
+    quint64 dealId;
+    std::array<int, 4> roundStartTotals;
+    bool roundPassed;
+    Hands roundPasses;
+    QVector<quint8> roundPlays;
 };
 
 class Game : public QObject {
@@ -65,15 +68,26 @@ public:
     static const int NUM_PLAYERS = 4;
     static const int CARDS_TO_PASS = 3;
 
-    explicit Game(QObject* parent = nullptr);
+    explicit Game(GameClock* clock, QObject* parent = nullptr);
 
     // Game control
-    void newGame();
+    void newGame();                      // Random seed
+    void newGame(std::uint64_t seed);    // Deals and AI play are a function of the seed
+    std::uint64_t seed() const { return m_seed; }
+    void suspend();  // Stop the match in place (e.g. while viewing a replay)
+
+    // Checkpointing: the current match as deal ID + move log, and the reverse
+    MatchCheckpoint checkpoint() const;
+    bool resumeMatch(const MatchCheckpoint& checkpoint);
+
+    // Game record of the round just played (valid once all 52 cards are down)
+    RoundRecord roundRecord() const;
+    quint32 matchId() const { return m_matchId; }
     void setAIDifficulty(AIDifficulty difficulty);
     AIDifficulty aiDifficulty() const;
 
     // Game rules
-    void setRules(const GameRules& rules) { m_rules = rules; }
+    void setRules(const GameRules& rules);
     const GameRules& rules() const { return m_rules; }
 
     // Human interactions
@@ -85,81 +99,95 @@ public:
     void undo();
 
     // State queries
-    GameState state() const { return m_state; }
-    int currentPlayer() const { return m_currentPlayer; }
+    GamePhase state() const { return m_state; }
+    const GameState& core() const { return m_core; }
+    int currentPlayer() const { return m_core.currentPlayer(); }
     int roundNumber() const { return m_roundNumber; }
     PassDirection passDirection() const { return m_passDirection; }
-    bool heartsBroken() const { return m_heartsBroken; }
-    bool isFirstTrick() const { return m_isFirstTrick; }
+    bool heartsBroken() const { return m_core.heartsBroken; }
+    bool isFirstTrick() const { return m_core.isFirstTrick(); }
 
     // Player queries
     Player* player(int index);
     const Player* player(int index) const;
-    const Cards& currentTrick() const { return m_currentTrick; }
-    const QVector<int>& trickPlayers() const { return m_trickPlayers; }
-    Suit leadSuit() const { return m_leadSuit; }
+    Cards currentTrick() const;
+    QVector<int> trickPlayers() const;
+    Suit leadSuit() const { return static_cast<Suit>(m_core.leadSuit); }
 
     // Valid moves for human
     Cards getValidPassCards() const;
     Cards getValidPlays() const;
 
 signals:
-    void stateChanged(GameState state);
+    void transition(const Transition& t);  // Once per engine step
     void cardsDealt();
     void passDirectionAnnounced(PassDirection dir);
     void passingComplete(Cards receivedCards);  // Cards received by human player
-    void cardPlayed(int player, Card card);
     void trickWon(int winner, int points);
     void roundEnded();
     void gameEnded(int winner);
-    void scoresChanged();
-    void currentPlayerChanged(int player);
-    void heartsBrokenSignal();
     void shootTheMoonOccurred(int shooter);
     void undoAvailableChanged(bool available);
-    void undoPerformed();  // Signal to refresh the view
+    void aiDecisionTimed(qint64 nsecs);  // Time one AI card choice took
 
 private:
-    void setState(GameState state);
+    // Marks the span of one engine step; the outermost one publishes
+    class Step {
+    public:
+        explicit Step(Game* game) : m_game(game) { m_game->m_stepDepth++; }
+        ~Step() { if (--m_game->m_stepDepth == 0) m_game->publishTransition(); }
+    private:
+        Game* m_game;
+    };
+
+    void markDirty(quint32 bits) { m_pending.dirty |= bits; }
+    void publishTransition();
+    void setState(GamePhase state);
     void dealCards();
     void startPassing();
     void executePassing();
     void startPlaying();
+    void playCard(const Card& card);
     void nextTurn();
     void aiTurn();
     void completeTrick();
     void endRound();
     void endGame();
-    int determineTrickWinner() const;
-    int findTwoOfClubsPlayer() const;
-    void updateHeartsBroken(const Card& card);
+    void syncPlayers();
 
     // Undo helpers
     void saveSnapshot();
     void restoreSnapshot(const GameSnapshot& snapshot);
 
-    GameState m_state;
+    GameClock* m_clock;  // Schedules the pauses between steps (MatchLane)
+    GamePhase m_state;
     int m_roundNumber;
     PassDirection m_passDirection;
-    int m_currentPlayer;
-    bool m_heartsBroken;
-    bool m_isFirstTrick;
     GameRules m_rules;
+    const RoundEngine* m_engine;  // Specialized for m_rules; set by setRules()
+
+    // Hands, trick and scores; mirrored into m_players by syncPlayers()
+    GameState m_core;
 
     std::array<std::unique_ptr<Player>, NUM_PLAYERS> m_players;
     QVector<Cards> m_passedCards; // Cards each player is passing
 
-    // Current trick
-    Cards m_currentTrick;
-    QVector<int> m_trickPlayers;
-    Suit m_leadSuit;
+    // Move log of the current round, for checkpoints and game records
+    std::uint64_t m_seed = 0;
+    quint32 m_matchId = 0;
+    quint64 m_dealId = 0;
+    std::array<int, NUM_PLAYERS> m_roundStartTotals = {0, 0, 0, 0};
+    bool m_roundPassed = false;
+    Hands m_roundPasses = {0, 0, 0, 0};
+    QVector<quint8> m_roundPlays;
 
     // Undo history
     QStack<GameSnapshot> m_undoHistory;
     static const int MAX_UNDO_HISTORY = 50;
 
-    // Generation counter to invalidate stale timer callbacks
-    int m_gameGeneration = 0;
+    // Changes collected during the current engine step
+    Transition m_pending;
+    int m_stepDepth = 0;
 };
 
 #endif // GAME_H
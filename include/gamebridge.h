@@ -2,19 +2,31 @@
 #define GAMEBRIDGE_H
 
 #include "game.h"
+#include "gameclock.h"
 #include "cardtheme.h"
+#include "cardatlas.h"
 #include "soundengine.h"
+#include "checkpoint.h"
+#include "replaysession.h"
+#include "handmodel.h"
+#include "trickmodel.h"
+#include "notifybatcher.h"
+#include "perfmonitor.h"
+#include "settingsstore.h"
+#include "statslog.h"
 #include <QObject>
+#include <QStringList>
 #include <QVariantList>
 #include <QUrl>
+#include <QElapsedTimer>
 
 class GameBridge : public QObject {
     Q_OBJECT
 
     // Core game state
-    Q_PROPERTY(QVariantList playerHand READ playerHand NOTIFY playerHandChanged)
+    Q_PROPERTY(HandModel* handModel READ handModel CONSTANT)
     Q_PROPERTY(QVariantList opponentCardCounts READ opponentCardCounts NOTIFY opponentCardCountsChanged)
-    Q_PROPERTY(QVariantList trickCards READ trickCards NOTIFY trickCardsChanged)
+    Q_PROPERTY(TrickModel* trickModel READ trickModel CONSTANT)
     Q_PROPERTY(QVariantList players READ players NOTIFY playersChanged)
     Q_PROPERTY(QString message READ message NOTIFY messageChanged)
     Q_PROPERTY(int passDirection READ passDirection NOTIFY passDirectionChanged)
@@ -24,10 +36,13 @@ class GameBridge : public QObject {
     Q_PROPERTY(bool gameOver READ gameOver NOTIFY gameOverChanged)
     Q_PROPERTY(int winner READ winner NOTIFY winnerChanged)
     Q_PROPERTY(bool undoAvailable READ undoAvailable NOTIFY undoAvailableChanged)
+    Q_PROPERTY(QString matchSeed READ matchSeed NOTIFY matchSeedChanged)
 
     // Settings
     Q_PROPERTY(QString themePath READ themePath WRITE setThemePath NOTIFY themePathChanged)
     Q_PROPERTY(int themeVersion READ themeVersion NOTIFY themeVersionChanged)
+    Q_PROPERTY(CardAtlas* cardAtlas READ cardAtlas CONSTANT)
+    Q_PROPERTY(PerfMonitor* perfMonitor READ perfMonitor CONSTANT)
     Q_PROPERTY(qreal cardScale READ cardScale WRITE setCardScale NOTIFY cardScaleChanged)
     Q_PROPERTY(bool soundEnabled READ soundEnabled WRITE setSoundEnabled NOTIFY soundEnabledChanged)
     Q_PROPERTY(int aiDifficulty READ aiDifficulty WRITE setAIDifficulty NOTIFY aiDifficultyChanged)
@@ -37,6 +52,9 @@ class GameBridge : public QObject {
     Q_PROPERTY(bool animateCardRotation READ animateCardRotation WRITE setAnimateCardRotation NOTIFY animateCardRotationChanged)
     Q_PROPERTY(bool animateAICards READ animateAICards WRITE setAnimateAICards NOTIFY animateAICardsChanged)
     Q_PROPERTY(bool animatePassingCards READ animatePassingCards WRITE setAnimatePassingCards NOTIFY animatePassingCardsChanged)
+    Q_PROPERTY(qreal timeScale READ timeScale WRITE setTimeScale NOTIFY timeScaleChanged)
+    Q_PROPERTY(qreal animationScale READ animationScale NOTIFY animationScaleChanged)
+    Q_PROPERTY(bool paused READ paused WRITE setPaused NOTIFY pausedChanged)
 
     // Game rules
     Q_PROPERTY(int endScore READ endScore WRITE setEndScore NOTIFY endScoreChanged)
@@ -58,15 +76,28 @@ class GameBridge : public QObject {
     Q_PROPERTY(double avgScore READ avgScore NOTIFY statisticsChanged)
     Q_PROPERTY(int bestScore READ bestScore NOTIFY statisticsChanged)
     Q_PROPERTY(int shootTheMoonCount READ shootTheMoonCount NOTIFY statisticsChanged)
+    Q_PROPERTY(int medianScore READ medianScore NOTIFY statisticsChanged)
+    Q_PROPERTY(int percentile90Score READ percentile90Score NOTIFY statisticsChanged)
+    Q_PROPERTY(double avgMatchMinutes READ avgMatchMinutes NOTIFY statisticsChanged)
+    Q_PROPERTY(QVariantList difficultyWinRates READ difficultyWinRates NOTIFY statisticsChanged)
+
+    // Replay
+    Q_PROPERTY(bool replayActive READ replayActive NOTIFY replayChanged)
+    Q_PROPERTY(QStringList replayMatches READ replayMatches NOTIFY replayChanged)
+    Q_PROPERTY(int replayMatch READ replayMatch NOTIFY replayChanged)
+    Q_PROPERTY(int replayRound READ replayRound NOTIFY replayChanged)
+    Q_PROPERTY(int replayRoundCount READ replayRoundCount NOTIFY replayChanged)
+    Q_PROPERTY(int replayTrick READ replayTrick NOTIFY replayChanged)
+    Q_PROPERTY(int replayPly READ replayPly NOTIFY replayChanged)
 
 public:
     explicit GameBridge(QObject* parent = nullptr);
     ~GameBridge();
 
     // Core state
-    QVariantList playerHand() const;
+    HandModel* handModel() const { return m_hand; }
     QVariantList opponentCardCounts() const;
-    QVariantList trickCards() const;
+    TrickModel* trickModel() const { return m_trick; }
     QVariantList players() const;
     QString message() const { return m_message; }
     int passDirection() const;
@@ -76,11 +107,14 @@ public:
     bool gameOver() const { return m_gameOver; }
     int winner() const { return m_winner; }
     bool undoAvailable() const { return m_undoAvailable; }
+    QString matchSeed() const { return QString::number(m_game->seed()); }
 
     // Settings
     QString themePath() const;
     void setThemePath(const QString& path);
     int themeVersion() const { return m_themeVersion; }
+    CardAtlas* cardAtlas() const { return m_atlas; }
+    PerfMonitor* perfMonitor() const { return m_perf; }
     qreal cardScale() const { return m_cardScale; }
     void setCardScale(qreal scale);
     bool soundEnabled() const { return m_soundEnabled; }
@@ -96,6 +130,11 @@ public:
     void setAnimateAICards(bool v);
     bool animatePassingCards() const { return m_animatePassingCards; }
     void setAnimatePassingCards(bool v);
+    qreal timeScale() const { return m_clock->timeScale(); }
+    void setTimeScale(qreal scale);
+    qreal animationScale() const { return m_clock->effectiveScale(); }  // Multiplies QML durations
+    bool paused() const { return m_clock->paused(); }
+    void setPaused(bool paused) { m_clock->setPaused(paused); }
 
     // Game rules
     int endScore() const;
@@ -109,13 +148,26 @@ public:
     bool fullPolish() const;
     void setFullPolish(bool v);
 
-    // Statistics
-    int gamesPlayed() const { return m_gamesPlayed; }
-    int gamesWon() const { return m_gamesWon; }
-    double winRate() const { return m_gamesPlayed > 0 ? 100.0 * m_gamesWon / m_gamesPlayed : 0; }
-    double avgScore() const { return m_gamesPlayed > 0 ? static_cast<double>(m_totalScore) / m_gamesPlayed : 0; }
-    int bestScore() const { return m_bestScore == 999 ? -1 : m_bestScore; }
-    int shootTheMoonCount() const { return m_shootTheMoonCount; }
+    // Statistics, read from the running aggregates in constant time
+    int gamesPlayed() const { return m_stats.aggregate().games; }
+    int gamesWon() const { return m_stats.aggregate().wins; }
+    double winRate() const { return gamesPlayed() > 0 ? 100.0 * gamesWon() / gamesPlayed() : 0; }
+    double avgScore() const { return m_stats.aggregate().meanScore(); }
+    int bestScore() const { return m_stats.aggregate().bestScore == 999 ? -1 : m_stats.aggregate().bestScore; }
+    int shootTheMoonCount() const { return m_stats.aggregate().moons; }
+    int medianScore() const { return m_stats.aggregate().scorePercentile(0.5); }
+    int percentile90Score() const { return m_stats.aggregate().scorePercentile(0.9); }
+    double avgMatchMinutes() const;
+    QVariantList difficultyWinRates() const;  // Percent per AIDifficulty; -1 if none played
+
+    // Replay
+    bool replayActive() const { return m_replayActive; }
+    QStringList replayMatches() const;
+    int replayMatch() const { return m_replay.currentMatch(); }
+    int replayRound() const { return m_replayRound; }
+    int replayRoundCount() const { return m_replay.roundCount(); }
+    int replayTrick() const { return m_replayPly / 4; }
+    int replayPly() const { return m_replayPly; }
 
     // Theme preview
     int previewVersion() const { return m_previewVersion; }
@@ -128,8 +180,22 @@ public:
     // Access to internal theme for image provider
     CardTheme* theme() const { return m_theme; }
 
+    // Window whose frames pace the batched notifications and feed the HUD
+    void setWindow(QQuickWindow* window) {
+        m_notify->setWindow(window);
+        m_perf->setWindow(window);
+    }
+
+    // Minimized: skip animations and run pending waits now
+    void setWindowHidden(bool hidden) { m_clock->setHidden(hidden); }
+
+    // Pending timed transitions, for tests and debugging
+    GameClock* clock() const { return m_clock; }
+
     // Invokable methods
     Q_INVOKABLE void newGame();
+    Q_INVOKABLE void resumeOrNewGame();
+    Q_INVOKABLE bool playSeed(const QString& seed);  // Decimal or 0x-prefixed hex
     Q_INVOKABLE void undo();
     Q_INVOKABLE void quit();
     Q_INVOKABLE void cardClicked(int suit, int rank);
@@ -140,11 +206,17 @@ public:
     Q_INVOKABLE QString scoresText() const;
     Q_INVOKABLE void loadPreviewTheme(const QString& path);
 
+    // Replay of recorded matches; the live match waits in its checkpoint
+    Q_INVOKABLE bool openReplay(const QString& path = QString());
+    Q_INVOKABLE void selectReplayMatch(int match);
+    Q_INVOKABLE void replaySeek(int round, int trick);
+    Q_INVOKABLE void replayStepForward();
+    Q_INVOKABLE void replayStepBack();
+    Q_INVOKABLE void closeReplay();
+
 signals:
     // Core state
-    void playerHandChanged();
     void opponentCardCountsChanged();
-    void trickCardsChanged();
     void playersChanged();
     void messageChanged();
     void passDirectionChanged();
@@ -154,6 +226,7 @@ signals:
     void gameOverChanged();
     void winnerChanged();
     void undoAvailableChanged();
+    void matchSeedChanged();
 
     // Settings
     void themePathChanged();
@@ -166,6 +239,9 @@ signals:
     void animateCardRotationChanged();
     void animateAICardsChanged();
     void animatePassingCardsChanged();
+    void timeScaleChanged();
+    void animationScaleChanged();
+    void pausedChanged();
 
     // Game rules
     void endScoreChanged();
@@ -177,6 +253,9 @@ signals:
     // Statistics
     void statisticsChanged();
 
+    // Replay
+    void replayChanged();
+
     // Theme preview
     void previewVersionChanged();
 
@@ -184,7 +263,6 @@ signals:
     void showMenuBarChanged();
 
     // Animation triggers
-    void cardPlayedToTrick(int player, int suit, int rank, qreal fromX, qreal fromY);
     void trickWonByPlayer(int player, int points);
     void cardsReceived(QVariantList cards);
     void heartsBrokenSignal();
@@ -194,32 +272,63 @@ signals:
     void openStatisticsRequested();
     void openSettingsRequested();
     void openAboutRequested();
+    void openSeedRequested();
     void toggleFullscreenRequested();
 
 private slots:
-    void onStateChanged(GameState state);
+    void onTransition(const Transition& t);
     void onCardsDealt();
     void onPassDirectionAnnounced(PassDirection dir);
     void onPassingComplete(Cards receivedCards);
-    void onCardPlayed(int player, Card card);
     void onTrickWon(int winner, int points);
     void onRoundEnded();
     void onGameEnded(int winner);
-    void onScoresChanged();
-    void onCurrentPlayerChanged(int player);
-    void onHeartsBroken();
 
 private:
+    // Table notifications batched by m_notify, emitted at most once per frame
+    enum Dirty : quint32 {
+        DirtyHand               = 1 << 0,  // Hand model needs a sync
+        DirtyOpponentCardCounts = 1 << 1,
+        DirtyPlayers            = 1 << 2,
+        DirtyGameState          = 1 << 3,
+        DirtyInputBlocked       = 1 << 4,
+        DirtySelectedCount      = 1 << 5,
+        DirtyPassDirection      = 1 << 6,
+        DirtyMessage            = 1 << 7,
+        DirtyReplay             = 1 << 8
+    };
+
+    void markDirty(quint32 bits) { m_notify->mark(bits); }
+    void flushNotifications(quint32 bits);
     void updateValidPlays();
+    void syncHand();
+    void syncTrick();
+    void setInputBlocked(bool blocked);
     void showMessage(const QString& text, int durationMs = 2000);
     void hideMessage();
     void loadSettings();
     void saveSettings();
-
+    void resetTableState();
+    void beginMatchStats();
+    void saveCheckpoint();
+    void seekReplay(int round, int ply);
+    void finishReplayTrick();
+    void leaveReplay();
+    void emitTableChanged();
+
+    GameClock* m_clock;
     Game* m_game;
     CardTheme* m_theme;
     CardTheme* m_previewTheme;
+    CardAtlas* m_atlas;
     SoundEngine* m_sound;
+    HandModel* m_hand;
+    TrickModel* m_trick;
+    NotifyBatcher* m_notify;
+    PerfMonitor* m_perf;
+    SettingsStore m_settings;
+    CheckpointStore m_checkpoints;
+    GameRecordWriter m_records;
     QString m_message;
     bool m_inputBlocked = false;
     bool m_gameOver = false;
@@ -235,7 +344,7 @@ private:
     bool m_passConfirmed = false;
     bool m_undoAvailable = false;
     bool m_soundEnabled = true;
-    QTimer* m_messageTimer = nullptr;
+    quint64 m_messageTimer = 0;  // Clock callback that hides the message
 
     // Animation settings
     bool m_animateCardRotation = true;
@@ -248,12 +357,19 @@ private:
     // UI
     bool m_showMenuBar = true;
 
+    // Replay
+    ReplaySession m_replay;
+    bool m_replayActive = false;
+    int m_replayRound = 0;
+    int m_replayPly = 0;
+    GameState m_replayState{};
+
     // Statistics
-    int m_gamesPlayed = 0;
-    int m_gamesWon = 0;
-    int m_totalScore = 0;
-    int m_bestScore = 999;
-    int m_shootTheMoonCount = 0;
+    StatsLog m_stats;
+    QElapsedTimer m_matchClock;
+    int m_lastTotals[4] = {0, 0, 0, 0};
+    quint8 m_matchMoons[4] = {0, 0, 0, 0};
+    qint8 m_roundScores[MatchStatsRecord::MAX_ROUNDS][4] = {};
 };
 
 #endif // GAMEBRIDGE_H
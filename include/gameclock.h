@@ -0,0 +1,118 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <QElapsedTimer>
+#include <QVector>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <functional>
+#include <map>
+
+// Owns every pending timed transition of the table: the engine's pauses
+// (Game), the view's (GameBridge, TrickModel) and replay playback. Callbacks
+// run from one timer in due order on the GUI thread, so there is a single
+// queue to pause, fast-forward, cancel or inspect instead of a web of
+// independent single-shot timers.
+//
+// Delays are written at normal speed and scaled by timeScale: 1 is normal,
+// 0 is instant. At 0 every wait is due immediately, but callbacks still run
+// from the event loop one after another, so signals keep their usual order.
+// While the window is hidden the effective scale is 0 and anything pending
+// is fast-forwarded.
+class GameClock : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(qreal timeScale READ timeScale WRITE setTimeScale NOTIFY timeScaleChanged)
+    Q_PROPERTY(qreal effectiveScale READ effectiveScale NOTIFY effectiveScaleChanged)
+    Q_PROPERTY(bool paused READ paused WRITE setPaused NOTIFY pausedChanged)
+
+public:
+    // Pending callbacks are grouped into lanes that are cancelled together
+    enum Lane {
+        MatchLane,   // Engine steps and the view waits tied to them
+        ReplayLane,  // Replay playback
+        TableLane,   // Purely visual cleanup (trick rows, messages)
+        LaneCount
+    };
+
+    // What introspection reports for one pending callback
+    struct Pending {
+        Lane lane;
+        const char* label;
+        qint64 remaining;  // ms of clock time
+    };
+
+    static const int FAST_FORWARD_LIMIT = 10000;  // Callbacks per fastForward(); stops runaway chains
+
+    explicit GameClock(QObject* parent = nullptr);
+
+    qreal timeScale() const { return m_timeScale; }
+    void setTimeScale(qreal scale);
+    qreal effectiveScale() const { return m_hidden ? 0.0 : m_timeScale; }
+
+    // `ms` at normal speed, scaled to the current speed
+    int scaled(int ms) const { return qRound(ms * effectiveScale()); }
+
+    // Runs `f` after `ms` (at normal speed) unless `lane` is cancelled or
+    // `context` destroyed first. Returns an ID for cancel(quint64).
+    quint64 after(int ms, Lane lane, QObject* context, std::function<void()> f, const char* label = "");
+
+    // Drops everything pending in `lane` and starts its next epoch
+    void cancel(Lane lane);
+    bool cancel(quint64 id);
+    quint32 epoch(Lane lane) const { return m_epochs[lane]; }
+
+    // A paused clock stands still: nothing fires and remaining times hold
+    bool paused() const { return m_paused; }
+    void setPaused(bool paused);
+
+    // Moves the clock forward by `ms`, running what falls due on the way
+    void advance(qint64 ms);
+
+    // Runs everything pending now, in order, including callbacks those
+    // schedule, until the queue is empty (e.g. the engine waits on the human)
+    void fastForward();
+
+    // Hidden windows skip animations: scale 0 and pending work runs now, or
+    // when a paused clock resumes
+    void setHidden(bool hidden);
+
+    // Introspection
+    int pendingCount() const { return static_cast<int>(m_queue.size()); }
+    int pendingCount(Lane lane) const;
+    QVector<Pending> pending() const;
+    QStringList describePending() const;
+
+signals:
+    void timeScaleChanged();
+    void effectiveScaleChanged();
+    void pausedChanged();
+
+private:
+    struct Entry {
+        quint64 id;
+        Lane lane;
+        QPointer<QObject> context;
+        std::function<void()> callback;
+        const char* label;
+    };
+    using Key = std::pair<qint64, quint64>;  // Due time, then scheduling order
+
+    qint64 now() const { return m_paused ? m_base : m_base + m_wall.elapsed(); }
+    void runDue();
+    void runFirst();
+    void rearm();
+
+    std::map<Key, Entry> m_queue;
+    QTimer m_timer;
+    QElapsedTimer m_wall;
+    qint64 m_base = 0;         // Clock time when m_wall last restarted
+    quint64 m_nextId = 1;
+    quint32 m_epochs[LaneCount] = {};
+    qreal m_timeScale = 1.0;
+    bool m_paused = false;
+    bool m_hidden = false;
+};
+
+#endif // GAMECLOCK_H
@@ -0,0 +1,117 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include "gamestate.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+class QFile;
+
+// Binary game-record stream shared by the GUI and the headless tools.
+//
+// File layout (little-endian):
+//   FileHeader
+//   { BlockHeader, RoundRecord[recordCount] } ...
+//
+// The file is append-only. Each block carries a CRC32 of its records, so a
+// torn write at the tail is detected and dropped. Records have a fixed size
+// and are 16-byte aligned in the file, so a memory-mapped reader can hand
+// out pointers straight into the mapping.
+
+// One complete round: 64 bytes
+struct RoundRecord {
+    std::uint64_t dealId;
+    std::uint32_t matchId;
+    std::uint8_t roundNumber;
+    std::uint8_t rules;          // RuleFlag bits
+    std::int16_t endScore;
+    std::uint8_t passes[9];      // 4 seats x 3 cards, 6 bits each (63 = no pass)
+    std::uint8_t plays[39];      // 52 cards in play order, 6 bits each
+
+    static RoundRecord make(std::uint32_t matchId, int roundNumber, std::uint64_t dealId,
+                            const GameRules& rules, const Hands& passes,
+                            const std::uint8_t plays[CARD_COUNT]);
+
+    int play(int i) const;            // i-th card played this round
+    CardSet passed(int seat) const;   // Cards `seat` passed (empty on hold rounds)
+    GameRules gameRules() const;
+};
+
+static_assert(sizeof(RoundRecord) == 64, "RoundRecord is an on-disk format");
+
+// CRC-32 used for block checksums
+std::uint32_t recordChecksum(const void* data, std::size_t size);
+
+class GameRecordWriter {
+public:
+    static const int RECORDS_PER_BLOCK = 1024;
+
+    GameRecordWriter() = default;
+    ~GameRecordWriter();
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+    // Opens for appending, creating the file or dropping a torn tail block.
+    // A file in another format or version is renamed to <path>.old (or
+    // .old.N) rather than overwritten.
+    bool open(const std::string& path);
+    bool isOpen() const { return m_file != nullptr; }
+
+    void append(const RoundRecord& record);  // Buffers; writes a block when full
+    void flush();                            // Writes buffered records as a block
+    void close();
+
+private:
+    std::FILE* m_file = nullptr;
+    std::vector<RoundRecord> m_pending;
+};
+
+// Memory-mapped, zero-copy reader. Blocks whose checksum fails are skipped
+// when the file is opened, so every block it serves has been verified.
+class GameRecordReader {
+public:
+    struct Block {
+        const RoundRecord* records;
+        std::uint32_t count;
+        std::uint32_t crc;
+        std::size_t firstRound;
+    };
+
+    GameRecordReader() = default;
+    ~GameRecordReader();
+    GameRecordReader(const GameRecordReader&) = delete;
+    GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    std::size_t roundCount() const { return m_roundCount; }
+    std::size_t blockCount() const { return m_blocks.size(); }
+    std::size_t skippedBlocks() const { return m_skippedBlocks; }   // Failed their CRC
+    const Block& block(std::size_t i) const { return m_blocks[i]; }
+    const RoundRecord& round(std::size_t i) const;  // Binary search over the block index
+
+    bool verifyBlock(std::size_t i) const;
+
+    // Calls f(const RoundRecord&) for every round in file order
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const Block& b : m_blocks) {
+            for (std::uint32_t i = 0; i < b.count; ++i) f(b.records[i]);
+        }
+    }
+
+private:
+    std::unique_ptr<QFile> m_file;
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_roundCount = 0;
+    std::size_t m_skippedBlocks = 0;
+    std::vector<Block> m_blocks;
+};
+
+#endif // GAMERECORD_H
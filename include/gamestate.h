@@ -0,0 +1,235 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "cardset.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+enum class PassDirection { Left, Right, Across, None };
+
+// Bits of GameState::rules
+enum RuleFlag : std::uint8_t {
+    RuleQueenBreaksHearts = 1 << 0,
+    RuleMoonProtection    = 1 << 1,
+    RuleFullPolish        = 1 << 2,
+    RuleExactResetTo50    = 1 << 3
+};
+
+// Game rules configuration
+struct GameRules {
+    int endScore = 100;              // Game ends when a player reaches this score
+    bool exactResetTo50 = false;     // If score is exactly endScore, reset to 50
+    bool queenBreaksHearts = true;   // Q♠ breaks hearts when played (standard: true)
+    bool moonProtection = false;     // If +26 to others would cause shooter to lose, they can take -26 instead
+    bool fullPolish = false;         // 99 points + takes 25 = reset to 98
+
+    // Default standard rules
+    static GameRules standard() {
+        return GameRules{100, false, true, false, false};
+    }
+
+    // Packed form stored in GameState::rules
+    std::uint8_t flags() const {
+        return (queenBreaksHearts ? RuleQueenBreaksHearts : 0) |
+               (moonProtection ? RuleMoonProtection : 0) |
+               (fullPolish ? RuleFullPolish : 0) |
+               (exactResetTo50 ? RuleExactResetTo50 : 0);
+    }
+};
+
+// Complete position of a match: hands, the trick in progress and scores.
+// A plain value type so search and simulation can copy and mutate it
+// freely; Game wraps one and adds timing and signals on top.
+struct GameState {
+    static const int NUM_PLAYERS = 4;
+
+    CardSet hands[NUM_PLAYERS];
+    std::int16_t roundScores[NUM_PLAYERS];
+    std::int16_t totalScores[NUM_PLAYERS];
+    std::uint8_t trick[NUM_PLAYERS];   // Cards in play order, trick[0] played by leader
+    std::uint8_t trickSize;
+    std::uint8_t leader;               // Player who led (or will lead) the current trick
+    std::uint8_t leadSuit;
+    std::uint8_t tricksPlayed;
+    std::uint8_t heartsBroken;
+    std::uint8_t rules;                // RuleFlag bits
+    std::int16_t endScore;
+
+    int currentPlayer() const { return (leader + trickSize) % NUM_PLAYERS; }
+    int trickPlayer(int i) const { return (leader + i) % NUM_PLAYERS; }
+    bool isFirstTrick() const { return tricksPlayed == 0; }
+    bool trickComplete() const { return trickSize == NUM_PLAYERS; }
+    bool roundComplete() const { return tricksPlayed == 13; }
+    bool hasRule(RuleFlag flag) const { return (rules & flag) != 0; }
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must stay a plain value type");
+static_assert(sizeof(GameState) <= 64, "GameState should fit in a cache line");
+
+using Hands = std::array<CardSet, GameState::NUM_PLAYERS>;
+
+// Fresh match: zero scores, no cards dealt
+GameState initialState(const GameRules& rules);
+
+// Start a round with the given hands; the holder of 2♣ leads
+GameState dealRound(const GameState& state, const Hands& hands);
+
+// Shuffled deal for a deal ID: an Rng(dealId) shuffle of the deck, dealt
+// in runs of 13. The same ID gives the same deal on every platform.
+Hands dealHands(std::uint64_t dealId);
+
+// Left, Right, Across, None cycle (rounds count from 1)
+PassDirection passDirectionForRound(int round);
+
+// Seat that receives the cards passed by `from`
+int passTarget(int from, PassDirection dir);
+
+// Exchange the passed cards and re-determine the opening leader
+GameState applyPass(const GameState& state, const Hands& passed, PassDirection dir);
+
+// Cards the current player may play (empty once the trick is full)
+CardSet legalMoves(const GameState& state);
+
+// Current player plays `card`. A full trick stays on the table until collectTrick().
+// Dispatches on state.rules per call; hot loops should use a RoundEngine.
+GameState applyMove(const GameState& state, int card);
+
+// Player currently winning the trick on the table
+int trickWinner(const GameState& state);
+
+// Points in the trick on the table
+int trickPoints(const GameState& state);
+
+// Award the full trick to its winner, who leads next
+GameState collectTrick(const GameState& state);
+
+// Apply Full Polish, shoot the moon and the exact-reset rule, then move round
+// scores into totals. `moonShooter` receives the shooter or -1.
+GameState scoreRound(const GameState& state, int* moonShooter = nullptr);
+
+bool matchOver(const GameState& state);
+
+// Lowest total score wins; ties go to the lower seat
+int matchWinner(const GameState& state);
+
+// ============================================================================
+// RULE VARIANTS
+// ============================================================================
+//
+// The rule-dependent steps are templated on a compile-time rule set, so each
+// of the 16 variants is compiled without per-card rule checks. endScore stays
+// a runtime value in GameState. dispatchRules() turns runtime flags into the
+// matching instantiation; pick it once per match, not once per card.
+
+template <std::uint8_t Flags>
+struct Rules {
+    static constexpr std::uint8_t flags = Flags;
+    static constexpr bool queenBreaksHearts = (Flags & RuleQueenBreaksHearts) != 0;
+    static constexpr bool moonProtection = (Flags & RuleMoonProtection) != 0;
+    static constexpr bool fullPolish = (Flags & RuleFullPolish) != 0;
+    static constexpr bool exactResetTo50 = (Flags & RuleExactResetTo50) != 0;
+};
+
+template <typename R>
+GameState applyMoveFor(const GameState& state, int card) {
+    GameState s = state;
+    s.hands[s.currentPlayer()] &= ~cardBit(card);
+    if (s.trickSize == 0) {
+        s.leadSuit = static_cast<std::uint8_t>(cardSuit(card));
+    }
+    s.trick[s.trickSize++] = static_cast<std::uint8_t>(card);
+
+    if (cardSuit(card) == HEARTS_SUIT || (R::queenBreaksHearts && card == QUEEN_OF_SPADES)) {
+        s.heartsBroken = 1;
+    }
+    return s;
+}
+
+template <typename R>
+GameState scoreRoundFor(const GameState& state, int* moonShooter) {
+    GameState s = state;
+    const int n = GameState::NUM_PLAYERS;
+
+    if (moonShooter) *moonShooter = -1;
+
+    // Full Polish: 99 points at start + takes exactly 25 = reset to 98
+    if (R::fullPolish) {
+        for (int i = 0; i < n; ++i) {
+            if (s.totalScores[i] == 99 && s.roundScores[i] == 25) {
+                s.roundScores[i] = -1;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (s.roundScores[i] != 26) continue;
+
+        if (moonShooter) *moonShooter = i;
+
+        // Moon protection: take -26 instead, but only if +26 to others would
+        // end the game with someone else below the shooter (lowest score wins)
+        bool takeNegative = false;
+        if (R::moonProtection) {
+            bool gameWouldEnd = false;
+            int lowestOtherScore = 999;
+            for (int j = 0; j < n; ++j) {
+                if (j == i) continue;
+                int otherNewTotal = s.totalScores[j] + 26;
+                if (otherNewTotal >= s.endScore) gameWouldEnd = true;
+                if (otherNewTotal < lowestOtherScore) lowestOtherScore = otherNewTotal;
+            }
+            takeNegative = gameWouldEnd && lowestOtherScore < s.totalScores[i];
+        }
+
+        if (!takeNegative) {
+            for (int j = 0; j < n; ++j) {
+                if (j != i) s.roundScores[j] = 26;
+            }
+        }
+        s.roundScores[i] -= 26;
+        break;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        s.totalScores[i] += s.roundScores[i];
+        s.roundScores[i] = 0;
+        if (R::exactResetTo50 && s.totalScores[i] == s.endScore) {
+            s.totalScores[i] = 50;
+        }
+    }
+    return s;
+}
+
+// Calls f(Rules<flags>{}) and returns its result
+template <typename F>
+decltype(auto) dispatchRules(std::uint8_t flags, F&& f) {
+    switch (flags & 0x0f) {
+        case 0x0: return f(Rules<0x0>{});
+        case 0x1: return f(Rules<0x1>{});
+        case 0x2: return f(Rules<0x2>{});
+        case 0x3: return f(Rules<0x3>{});
+        case 0x4: return f(Rules<0x4>{});
+        case 0x5: return f(Rules<0x5>{});
+        case 0x6: return f(Rules<0x6>{});
+        case 0x7: return f(Rules<0x7>{});
+        case 0x8: return f(Rules<0x8>{});
+        case 0x9: return f(Rules<0x9>{});
+        case 0xa: return f(Rules<0xa>{});
+        case 0xb: return f(Rules<0xb>{});
+        case 0xc: return f(Rules<0xc>{});
+        case 0xd: return f(Rules<0xd>{});
+        case 0xe: return f(Rules<0xe>{});
+        default:  return f(Rules<0xf>{});
+    }
+}
+
+// Rule-specialized entry points for callers that can't be templates
+struct RoundEngine {
+    GameState (*applyMove)(const GameState& state, int card);
+    GameState (*scoreRound)(const GameState& state, int* moonShooter);
+};
+
+const RoundEngine& roundEngine(std::uint8_t rules);
+
+#endif // GAMESTATE_H
@@ -0,0 +1,56 @@
+#ifndef HANDMODEL_H
+#define HANDMODEL_H
+
+#include "card.h"
+#include <QAbstractListModel>
+
+// South's hand as a list model, one row per card in sorted order. The hand
+// and its flags are stored as bitboards; setters diff against the previous
+// value and emit row inserts/removes or dataChanged for just the affected
+// rows, so delegates survive across updates.
+class HandModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Role {
+        SuitRole = Qt::UserRole + 1,
+        RankRole,
+        ElementIdRole,
+        PlayableRole,
+        SelectedRole,
+        ReceivedRole
+    };
+
+    explicit HandModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return cardCount(m_cards); }
+    CardSet cards() const { return m_cards; }
+
+    // Row of a card, or -1 if it's not in the hand
+    Q_INVOKABLE int indexOf(int suit, int rank) const;
+
+    void setCards(CardSet cards);
+    void setPlayable(CardSet cards) { setFlags(m_playable, cards, PlayableRole); }
+    void setSelected(CardSet cards) { setFlags(m_selected, cards, SelectedRole); }
+    void setReceived(CardSet cards) { setFlags(m_received, cards, ReceivedRole); }
+
+signals:
+    void countChanged();
+
+private:
+    int rowOf(int card) const { return cardCount(m_cards & (cardBit(card) - 1)); }
+    int cardAt(int row) const;
+    void setFlags(CardSet& flags, CardSet cards, int role);
+
+    CardSet m_cards = 0;
+    CardSet m_playable = 0;
+    CardSet m_selected = 0;
+    CardSet m_received = 0;
+};
+
+#endif // HANDMODEL_H
@@ -0,0 +1,38 @@
+#ifndef NOTIFYBATCHER_H
+#define NOTIFYBATCHER_H
+
+#include <QObject>
+#include <QPointer>
+
+class QQuickWindow;
+
+// Collects dirty bits for property notifications and hands them out once per
+// frame, from the window's beforeSynchronizing, so bindings on a property
+// re-evaluate at most once per frame however often it changed. The app
+// renders through QQuickWidget, so that signal arrives on the GUI thread.
+// Without a window (or before one is attached) bits flush on the next
+// event-loop pass instead.
+class NotifyBatcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit NotifyBatcher(QObject* parent = nullptr);
+
+    void setWindow(QQuickWindow* window);
+
+    // Schedule the notifications in `bits` for the next flush
+    void mark(quint32 bits);
+
+    // Hand out everything pending now
+    void flush();
+
+signals:
+    void flushed(quint32 bits);
+
+private:
+    QPointer<QQuickWindow> m_window;
+    quint32 m_pending = 0;
+    bool m_scheduled = false;
+};
+
+#endif // NOTIFYBATCHER_H
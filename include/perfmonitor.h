@@ -0,0 +1,121 @@
+#ifndef PERFMONITOR_H
+#define PERFMONITOR_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include <QtQml/qqmlregistration.h>
+#include <atomic>
+
+class CardTheme;
+class QQuickWindow;
+
+// Frame and latency diagnostics behind the performance HUD. Samples are
+// kept per metric in fixed rings (the last SAMPLES of each) and summarised
+// as percentiles twice a second while recording. Nothing is measured while
+// disabled; the window hooks and the timestamps are skipped.
+//
+// record() may be called from any thread (image providers run on worker
+// threads); everything else is GUI-thread only.
+class PerfMonitor : public QObject {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Owned by gameBridge")
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QVariantList summary READ summary NOTIFY summaryChanged)
+    Q_PROPERTY(qint64 startupMs READ startupMs NOTIFY startupMsChanged)
+    Q_PROPERTY(QVariantMap cardCache READ cardCache NOTIFY summaryChanged)
+
+public:
+    enum Metric {
+        FrameTime,     // Between QQuickWindow::frameSwapped (afterFrameEnd offscreen)
+        SyncTime,      // beforeSynchronizing .. afterSynchronizing
+        RenderTime,    // beforeRendering .. afterRendering
+        ImageRequest,  // CardImageProvider render job, on a worker
+        AtlasBuild,    // CardAtlas painting one size
+        AiDecision,    // aiPlayDecision for one card
+        InputLatency,  // cardClicked .. the next swapped frame
+        MetricCount
+    };
+    Q_ENUM(Metric)
+
+    static const int SAMPLES = 2048;           // Per metric
+    static const int SUMMARY_INTERVAL = 500;   // ms between HUD refreshes
+
+    explicit PerfMonitor(QObject* parent = nullptr);
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    void setWindow(QQuickWindow* window);
+
+    // One measurement of `metric`, in nanoseconds
+    void record(Metric metric, qint64 nsecs);
+
+    // Input handled now; its latency ends at the next swapped frame
+    void markInput();
+
+    // From the start of main() to the first rendered frame; -1 until then
+    qint64 startupMs() const { return m_startupMs; }
+    void setStartupMs(qint64 ms);
+
+    // Per metric: name, count, p50, p95, p99 and max in ms
+    QVariantList summary() const { return m_summary; }
+
+    // The card image cache: images, bytes, budget, hits and misses
+    void setCardTheme(CardTheme* theme) { m_cardTheme = theme; }
+    QVariantMap cardCache() const { return m_cardCache; }
+
+    // Every sample held, as "metric,time_ms,value_ms" rows. Written to
+    // `path`, or a timestamped file in the app data directory when empty.
+    // Returns the path written, or an empty string on failure.
+    Q_INVOKABLE QString dumpCsv(const QString& path = QString()) const;
+
+    Q_INVOKABLE void reset();
+
+    static const char* metricName(Metric metric);
+
+signals:
+    void enabledChanged();
+    void summaryChanged();
+    void startupMsChanged();
+
+private:
+    struct Sample {
+        qint64 at;     // ns since the monitor started
+        qint64 value;  // ns
+    };
+    struct Ring {
+        QVector<Sample> samples;
+        int next = 0;
+        bool full = false;
+    };
+
+    void connectWindow();
+    void updateSummary();
+
+    QPointer<QQuickWindow> m_window;
+    QVector<QMetaObject::Connection> m_connections;
+    std::atomic<bool> m_enabled{false};   // Read by record() on any thread
+    QTimer m_summaryTimer;
+    QVariantList m_summary;
+    CardTheme* m_cardTheme = nullptr;
+    QVariantMap m_cardCache;
+    qint64 m_startupMs = -1;
+
+    QElapsedTimer m_clock;
+    qint64 m_lastSwap = -1;    // Window hooks run on the render thread
+    qint64 m_syncStart = 0;
+    qint64 m_renderStart = 0;
+    std::atomic<qint64> m_inputAt{-1};
+
+    mutable QMutex m_mutex;    // Guards m_rings
+    Ring m_rings[MetricCount];
+};
+
+#endif // PERFMONITOR_H
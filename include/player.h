@@ -2,11 +2,11 @@
 #define PLAYER_H
 
 #include "card.h"
+#include "rng.h"
 #include <QString>
 #include <QSet>
 #include <QMap>
 #include <functional>
-#include <random>
 
 enum class AIDifficulty {
     Easy,
@@ -121,11 +121,12 @@ public:
     AIDifficulty difficulty() const { return m_difficulty; }
     void setDifficulty(AIDifficulty diff) { m_difficulty = diff; }
 
-    // Get valid cards for current situation
-    Cards getValidPlays(Suit leadSuit, bool isFirstTrick, bool heartsBroken) const;
+    // Get valid cards for current situation (legalMoves() from this seat)
+    Cards getValidPlays(Suit leadSuit, bool leading, bool isFirstTrick, bool heartsBroken) const;
 
-    // Shared RNG for AI decisions
-    static std::mt19937& rng();
+    // AI randomness is reseeded by Game before every decision, so each
+    // choice depends only on the match seed and the position
+    void seedDecision(std::uint64_t seed) { m_rng = Rng(seed); }
 
 private:
     int m_id;
@@ -137,6 +138,7 @@ private:
     AIDifficulty m_difficulty;
     CardMemory m_cardMemory;
     GameContext m_gameContext;
+    Rng m_rng;
 
     // AI helpers
     Card aiSelectLead(const Cards& valid, bool heartsBroken);
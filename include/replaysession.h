@@ -0,0 +1,53 @@
+#ifndef REPLAYSESSION_H
+#define REPLAYSESSION_H
+
+#include "gamerecord.h"
+#include <QString>
+#include <QVector>
+#include <array>
+
+// Recorded matches loaded from a game-record file, rebuilt so any position
+// can be reached without replaying the match from the start.
+//
+// A position is (round, ply): ply counts cards played in the round, 0..52.
+// Each round keeps a GameState keyframe every KEYFRAME_TRICKS tricks, so a
+// seek copies one keyframe and applies at most a few tricks of plays.
+class ReplaySession {
+public:
+    static const int KEYFRAME_TRICKS = 4;
+    static const int PLIES_PER_KEYFRAME = KEYFRAME_TRICKS * GameState::NUM_PLAYERS;
+    static const int KEYFRAMES_PER_ROUND = (CARD_COUNT - 1) / PLIES_PER_KEYFRAME + 1;
+
+    bool load(const QString& path);
+    void clear();
+
+    int matchCount() const { return m_matches.size(); }
+    quint32 matchId(int match) const { return m_matches[match].first().matchId; }
+    int matchRoundCount(int match) const { return m_matches[match].size(); }
+
+    // Rebuilds keyframes for one match; false if its records don't replay
+    bool selectMatch(int match);
+    int currentMatch() const { return m_currentMatch; }
+
+    int roundCount() const { return m_rounds.size(); }
+    int roundNumber(int round) const { return m_rounds[round].record.roundNumber; }
+    PassDirection passDirection(int round) const { return passDirectionForRound(roundNumber(round)); }
+
+    int play(int round, int ply) const { return m_rounds[round].record.play(ply); }
+    GameState stateAt(int round, int ply) const;  // Completed tricks collected
+    GameState finalState(int round) const { return m_rounds[round].scored; }
+
+private:
+    struct Round {
+        RoundRecord record;
+        const RoundEngine* engine;  // For this round's rules; they can change mid-match
+        std::array<GameState, KEYFRAMES_PER_ROUND> keyframes;
+        GameState scored;  // After scoring (next round's totals)
+    };
+
+    QVector<QVector<RoundRecord>> m_matches;
+    QVector<Round> m_rounds;
+    int m_currentMatch = -1;
+};
+
+#endif // REPLAYSESSION_H
@@ -0,0 +1,75 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// Portable pseudo-random generator (xoshiro256**, seeded through SplitMix64).
+// Unlike std::mt19937 + std::uniform_int_distribution/std::shuffle, every
+// step here is specified, so a seed gives the same deal and the same AI
+// decisions on every platform and standard library.
+
+// SplitMix64 finalizer: scrambles a 64-bit value
+inline std::uint64_t mixSeed(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Seed of an independent stream under `seed` (e.g. one per round or decision)
+inline std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t stream) {
+    return mixSeed(seed ^ mixSeed(stream));
+}
+
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = 0) {
+        for (std::uint64_t& word : m_s) {
+            seed += 0x9e3779b97f4a7c15ull;
+            word = mixSeed(seed);
+        }
+    }
+
+    std::uint64_t next() {
+        std::uint64_t result = rotl(m_s[1] * 5, 7) * 9;
+        std::uint64_t t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, n) without modulo bias
+    int below(int n) {
+        std::uint64_t bound = static_cast<std::uint64_t>(n);
+        std::uint64_t limit = -bound % bound;  // 2^64 mod n
+        std::uint64_t x;
+        do {
+            x = next();
+        } while (x < limit);
+        return static_cast<int>(x % bound);
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t m_s[4];
+};
+
+// Fisher-Yates shuffle, back to front
+template <typename It>
+void shuffleRange(It first, It last, Rng& rng) {
+    for (auto i = last - first - 1; i > 0; --i) {
+        auto j = rng.below(static_cast<int>(i) + 1);
+        auto tmp = first[i];
+        first[i] = first[j];
+        first[j] = tmp;
+    }
+}
+
+#endif // RNG_H
@@ -0,0 +1,56 @@
+#ifndef SERVER_EVENTLOOP_H
+#define SERVER_EVENTLOOP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Single-threaded epoll reactor. Handlers run on the thread that called
+// run(); post() and stop() are the only members safe to call from others.
+class EventLoop {
+public:
+    using Handler = std::function<void(std::uint32_t events)>;
+
+    EventLoop();
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool isValid() const { return m_epoll >= 0 && m_wake >= 0; }
+
+    // Watch `fd` for EPOLLIN/EPOLLOUT/... The loop doesn't own the descriptor.
+    bool add(int fd, std::uint32_t events, Handler handler);
+    void modify(int fd, std::uint32_t events);
+    void remove(int fd);  // Safe from inside the fd's own handler
+
+    // Queue `task` to run on the loop thread
+    void post(std::function<void()> task);
+
+    void run();
+    void stop();
+
+private:
+    struct Watch {
+        std::uint64_t token;  // Generation << 32 | fd, so stale events are dropped
+        Handler handler;
+    };
+
+    void wake();
+    void runPosted();
+
+    int m_epoll = -1;
+    int m_wake = -1;  // eventfd that interrupts epoll_wait
+    std::atomic<bool> m_running{false};
+    std::uint32_t m_generation = 0;
+
+    std::vector<std::unique_ptr<Watch>> m_watches;  // Indexed by fd
+    std::vector<std::unique_ptr<Watch>> m_retired;  // Removed during dispatch
+
+    std::mutex m_postMutex;
+    std::vector<std::function<void()>> m_posted;
+};
+
+#endif // SERVER_EVENTLOOP_H
@@ -0,0 +1,37 @@
+#ifndef SERVER_PROTOCOL_H
+#define SERVER_PROTOCOL_H
+
+#include "cardcodes.h"
+
+// hearts-server line protocol. Every message is one '\n'-terminated line of
+// space-separated words. Cards use the codes from cardcodes.h.
+//
+// Client -> server
+//   CREATE <humans 1-4> [easy|medium|hard] [seed]  Open a table; seats past
+//                                                   `humans` are AI
+//   JOIN <table>                                    Take an open human seat
+//   LIST                                            Tables with open seats
+//   PASS <card> <card> <card>
+//   PLAY <card>
+//   LEAVE                                           AI takes over the seat
+//   QUIT
+//
+// Server -> client
+//   HELLO <protocol version>
+//   SEAT <table> <seat>                  Reply to CREATE/JOIN
+//   TABLES {<table>:<open seats>}...     Reply to LIST
+//   START <seed>                         All human seats are filled
+//   DEAL <round> <L|R|A|N> <13 cards>    Your hand; pass unless N
+//   RECEIVED <3 cards>                   Cards passed to you
+//   TURN <seat>                          Seat to play
+//   LEGAL <cards>                        Your turn: the cards you may play
+//   PLAYED <seat> <card>
+//   TRICK <winner> <points>
+//   ROUND <moon shooter or -1> <4 totals>
+//   OVER <winner> <4 totals>
+//   OK
+//   ERR <reason>
+
+static const int PROTOCOL_VERSION = 1;
+
+#endif // SERVER_PROTOCOL_H
@@ -0,0 +1,92 @@
+#ifndef SERVER_SERVER_H
+#define SERVER_SERVER_H
+
+#include "server/eventloop.h"
+#include "server/table.h"
+#include "server/workerpool.h"
+#include "gamerecord.h"
+#include <csignal>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Hosts many tables in one process. Sockets and table logic run on a single
+// epoll loop; AI decisions go to the worker pool and come back via post().
+class Server {
+public:
+    struct Options {
+        std::string socketPath;   // Unix domain socket; empty to disable
+        int tcpPort = 0;          // Port on 127.0.0.1; 0 to disable
+        int workers = 0;          // AI threads; 0 for one per core
+        std::string recordPath;   // Game-record stream for finished rounds; empty to disable
+    };
+
+    explicit Server(const Options& options);
+    ~Server();
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Opens the listeners and the record stream. Reports failures on stderr.
+    bool listen();
+
+    // Stop the loop when one of `signals` arrives. They must already be
+    // blocked in every thread (block them before constructing the Server).
+    bool stopOnSignals(const sigset_t& signals);
+
+    void run();
+    void stop();
+
+private:
+    static const std::size_t MAX_LINE = 512;
+    static const std::size_t MAX_OUTPUT = 1 << 20;  // Slow readers past this are dropped
+
+    struct Connection {
+        int id;
+        int fd;
+        std::string input;
+        std::string output;
+        std::shared_ptr<Table> table;
+        int seat = -1;
+        bool writeArmed = false;  // Waiting for EPOLLOUT
+        bool closing = false;     // Close once output drains
+        bool dead = false;        // Close is queued; ignore further I/O
+    };
+
+    bool listenOn(int fd, const char* what);
+    void acceptAll(int listenFd, bool tcp);
+    void onEvent(int id, std::uint32_t events);
+    void readInput(Connection& conn);
+    void handleLine(Connection& conn, const std::string& line);
+
+    void createTable(Connection& conn, const std::vector<std::string>& args);
+    void joinTable(Connection& conn, const std::vector<std::string>& args);
+    void listTables(Connection& conn);
+    void leaveTable(Connection& conn);
+
+    void queue(Connection& conn, const std::string& line);
+    void flush(Connection& conn);
+    void drop(Connection& conn);
+    void closeConnection(int id);
+    Connection* connection(int id);
+
+    // Route a table's messages, save finished rounds and start the next AI decision
+    void afterTableChange(const std::shared_ptr<Table>& table, const Table::Messages& out);
+    void advance(const std::shared_ptr<Table>& table);
+
+    Options m_options;
+    EventLoop m_loop;
+    WorkerPool m_pool;  // After m_loop: workers post to the loop until joined
+
+    std::vector<int> m_listeners;
+    int m_signalFd = -1;
+    GameRecordWriter m_records;
+
+    std::unordered_map<int, std::unique_ptr<Connection>> m_connections;
+    std::unordered_map<int, std::shared_ptr<Table>> m_tables;
+    int m_nextConnection = 1;
+    int m_nextTable = 1;
+    std::uint64_t m_seedCounter;
+};
+
+#endif // SERVER_SERVER_H
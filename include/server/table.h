@@ -0,0 +1,110 @@
+#ifndef SERVER_TABLE_H
+#define SERVER_TABLE_H
+
+#include "gamestate.h"
+#include "gamerecord.h"
+#include "player.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One match on the server: the GameState core plus seat bookkeeping and
+// the AI players. Pure state machine without I/O; every action appends
+// the protocol lines it produces to a Messages list for the server to route.
+//
+// All members run on the event-loop thread except runAi(), which a worker
+// calls between takeAiJob() and finishAi(). While a job is out the table
+// doesn't touch the AI players, so runAi() can use them unlocked.
+class Table {
+public:
+    static const int NUM_SEATS = GameState::NUM_PLAYERS;
+    static const int CARDS_TO_PASS = 3;
+
+    enum class Phase { Waiting, Passing, Playing, Over };
+
+    struct Message {
+        int seat;  // -1 for every seat
+        std::string line;
+    };
+    using Messages = std::vector<Message>;
+
+    struct AiJob {
+        enum Kind { Pass, Play } kind;
+        GameState state;
+        std::uint64_t dealId;
+        int roundNumber;
+        int ply;
+        std::array<bool, NUM_SEATS> seats;  // Seats to decide for
+    };
+
+    struct AiResult {
+        AiJob job;
+        Hands passes;
+        int card;
+    };
+
+    Table(int id, int humanSeats, AIDifficulty difficulty, std::uint64_t seed, const GameRules& rules);
+
+    int id() const { return m_id; }
+    Phase phase() const { return m_phase; }
+    std::uint64_t seed() const { return m_seed; }
+    int openSeats() const;
+    int humanCount() const;
+    int connection(int seat) const { return m_connections[seat]; }
+
+    // Seats a connection in an open human seat; returns the seat or -1.
+    // The match starts once the last one is taken.
+    int join(int connection, Messages& out);
+
+    // The connection leaves. Before the match starts the seat reopens;
+    // after that an AI plays it.
+    void leave(int seat);
+
+    // Human moves. On a rejected move `error` says why.
+    bool pass(int seat, CardSet cards, Messages& out, std::string& error);
+    bool play(int seat, int card, Messages& out, std::string& error);
+
+    bool takeAiJob(AiJob& job);
+    AiResult runAi(const AiJob& job);
+    void finishAi(const AiResult& result, Messages& out);
+
+    // Rounds finished since the last call
+    std::vector<RoundRecord> takeRecords();
+
+private:
+    static const int OPEN_SEAT = -2;  // Reserved for a human who hasn't joined
+    static const int AI_SEAT = -1;
+
+    bool isAi(int seat) const { return m_connections[seat] == AI_SEAT; }
+
+    void startRound(Messages& out);
+    void executePass(Messages& out);
+    void applyPlay(int card, Messages& out);
+    void announceTurn(Messages& out);
+    void endRound(Messages& out);
+
+    int m_id;
+    std::uint64_t m_seed;
+    std::uint32_t m_matchId;
+    GameRules m_rules;
+    const RoundEngine* m_engine;
+    Phase m_phase = Phase::Waiting;
+
+    GameState m_core;
+    int m_roundNumber = 0;
+    std::uint64_t m_dealId = 0;
+    PassDirection m_passDirection = PassDirection::Left;
+    Hands m_passes = {0, 0, 0, 0};
+    std::array<bool, NUM_SEATS> m_passChosen = {false, false, false, false};
+    std::uint8_t m_plays[CARD_COUNT] = {};
+    int m_playCount = 0;
+    std::vector<RoundRecord> m_records;
+
+    std::array<int, NUM_SEATS> m_connections;
+    std::array<std::unique_ptr<Player>, NUM_SEATS> m_players;
+    bool m_aiBusy = false;
+};
+
+#endif // SERVER_TABLE_H
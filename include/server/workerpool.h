@@ -0,0 +1,33 @@
+#ifndef SERVER_WORKERPOOL_H
+#define SERVER_WORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads draining a FIFO of tasks. Used for AI decisions so
+// the event loop never blocks on search.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads);
+    ~WorkerPool();  // Finishes queued tasks, then joins
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task);
+    int threadCount() const { return static_cast<int>(m_threads.size()); }
+
+private:
+    void work();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopping = false;
+};
+
+#endif // SERVER_WORKERPOOL_H
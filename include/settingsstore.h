@@ -0,0 +1,40 @@
+#ifndef SETTINGSSTORE_H
+#define SETTINGSSTORE_H
+
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariantMap>
+
+// Application settings held in memory and written behind. setValue() only
+// marks the store dirty; a debounce timer then writes the whole map as JSON
+// on a background thread, atomically (temp file + rename), so a burst of
+// changes (dragging a slider) costs one write. flush() and the destructor
+// write synchronously for quit.
+class SettingsStore {
+public:
+    explicit SettingsStore(const QString& path = defaultPath());
+    ~SettingsStore();
+
+    static QString defaultPath();
+
+    QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
+    void setValue(const QString& key, const QVariant& value);
+    void remove(const QString& key);
+
+    // Write pending changes now and wait for them to land
+    void flush();
+
+private:
+    static const int WRITE_DELAY = 500;  // ms of quiet before a write
+
+    void writeBehind();
+
+    QString m_path;
+    QVariantMap m_values;
+    bool m_dirty = false;
+    QTimer m_debounce;
+    QThreadPool m_writer;  // Single thread keeps writes in order
+};
+
+#endif // SETTINGSSTORE_H
@@ -0,0 +1,63 @@
+#ifndef SIM_BOTPROTOCOL_H
+#define SIM_BOTPROTOCOL_H
+
+#include "cardcodes.h"
+#include <cstdint>
+#include <string>
+
+// hearts-sim engine protocol, in the spirit of UCI. The simulator starts the
+// engine as a child process and talks to it over stdin/stdout, one
+// '\n'-terminated line per message.
+//
+// Simulator -> engine
+//   hearts <version>                 Handshake
+//   go <id> <pass|play> <position>   Decide for the seat in <position>
+//   quit
+//
+// <position> is a list of keyword/value pairs; card lists are comma
+// separated, "-" when empty:
+//   seat <s> round <n> dir <L|R|A|N> rules <RuleFlag bits> end <end score>
+//   totals <4 scores> points <4 round scores> broken <0|1>
+//   hand <cards> passed <cards> received <cards>
+//   history <seat:card,...>   Every card played this round, in order; the
+//                             last (count % 4) entries are the open trick
+//   legal <cards>             Cards this move may use (the hand when passing)
+//
+// Engine -> simulator
+//   ready [name]                     Reply to the handshake
+//   pass <id> <card> <card> <card>
+//   play <id> <card>
+//   info <anything>                  Ignored
+//
+// Requests are self-contained, so one engine process can serve many
+// matches at once. The simulator batches all pending requests into one
+// write and doesn't wait for a reply before sending the next one; answers
+// may come back in any order. A request gets the per-move time limit once
+// for itself and once for every request already queued at the engine.
+
+static const int BOT_PROTOCOL_VERSION = 1;
+
+struct BotPosition {
+    GameState state;          // Position to decide in; state.currentPlayer() when playing
+    int seat;
+    int roundNumber;
+    PassDirection direction;
+    CardSet passed;           // What `seat` passed this round
+    CardSet received;         // What `seat` was passed
+    const std::uint8_t* plays;      // Cards played this round, in order
+    const std::uint8_t* playSeats;  // Who played each of them
+    int playCount;
+};
+
+std::string formatRequest(int id, bool pass, const BotPosition& position);
+
+struct BotReply {
+    enum Kind { Ready, Pass, Play, Ignored, Malformed } kind = Ignored;
+    int id = -1;
+    CardSet cards = 0;       // Pass: three cards; Play: one
+    std::string name;        // Ready
+};
+
+BotReply parseReply(const std::string& line);
+
+#endif // SIM_BOTPROTOCOL_H
@@ -0,0 +1,47 @@
+#ifndef SIM_ENGINEPROCESS_H
+#define SIM_ENGINEPROCESS_H
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+// An external engine running as a child process (via /bin/sh -c) with its
+// stdin and stdout on non-blocking pipes. Output is buffered until flush()
+// so a batch of requests goes out in one write.
+class EngineProcess {
+public:
+    explicit EngineProcess(const std::string& command);
+    ~EngineProcess();  // Says quit, closes the pipes and reaps the child
+    EngineProcess(const EngineProcess&) = delete;
+    EngineProcess& operator=(const EngineProcess&) = delete;
+
+    // Spawns the engine and waits up to `timeoutMs` for its "ready"
+    bool start(int timeoutMs);
+
+    const std::string& command() const { return m_command; }
+    const std::string& name() const { return m_name; }
+    bool isAlive() const { return m_in >= 0 && m_out >= 0; }
+
+    int readFd() const { return m_out; }
+    int writeFd() const { return m_in; }
+    bool wantsWrite() const { return !m_pending.empty(); }
+
+    void send(const std::string& line);
+    void flush();  // Writes what the pipe takes; the rest waits for the next flush
+
+    // Appends complete lines read so far. Returns false once the engine has exited.
+    bool readLines(std::vector<std::string>& lines);
+
+private:
+    void shutdown();
+
+    std::string m_command;
+    std::string m_name;
+    pid_t m_pid = -1;
+    int m_in = -1;   // Engine's stdin
+    int m_out = -1;  // Engine's stdout
+    std::string m_pending;
+    std::string m_input;
+};
+
+#endif // SIM_ENGINEPROCESS_H
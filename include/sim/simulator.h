@@ -0,0 +1,124 @@
+#ifndef SIM_SIMULATOR_H
+#define SIM_SIMULATOR_H
+
+#include "sim/botprotocol.h"
+#include "sim/engineprocess.h"
+#include "gamerecord.h"
+#include "player.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Plays a batch of seeded matches between built-in AIs and external
+// engines. Many matches are in flight at once so requests to an engine can
+// be pipelined; built-in seats decide inline.
+class Simulator {
+public:
+    static const int NUM_SEATS = GameState::NUM_PLAYERS;
+
+    struct Options {
+        std::array<std::string, NUM_SEATS> seats = {"medium", "medium", "medium", "medium"};
+        int matches = 100;
+        int parallel = 32;          // Matches in flight
+        std::uint64_t seed = 1;     // Match k plays seed deriveSeed(seed, k)
+        int moveTimeMs = 1000;
+        bool rotate = false;        // Shift participants one seat per match
+        GameRules rules = GameRules::standard();
+        std::string recordPath;
+    };
+
+    explicit Simulator(const Options& options);
+    ~Simulator();
+
+    // Parses the seat specs and starts the engines. Reports problems on stderr.
+    bool setup();
+    void run();
+    void report(std::FILE* out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Participant {
+        std::string spec;
+        AIDifficulty difficulty = AIDifficulty::Medium;
+        int engine = -1;  // Index into m_engines, or -1 for a built-in AI
+
+        int matches = 0;
+        int wins = 0;
+        long long scoreSum = 0;
+        int moons = 0;
+
+        // External engines only
+        int requests = 0;
+        int timeouts = 0;
+        int illegal = 0;
+        double latencySumMs = 0;
+    };
+
+    struct Match {
+        int index;
+        std::uint64_t seed;
+        std::uint32_t matchId;
+        std::array<int, NUM_SEATS> participant;
+        std::array<std::unique_ptr<Player>, NUM_SEATS> players;  // AI state and card memory
+
+        GameState core;
+        int roundNumber = 0;
+        std::uint64_t dealId = 0;
+        PassDirection direction = PassDirection::Left;
+        bool passing = false;
+        bool over = false;
+        Hands passes = {0, 0, 0, 0};
+        std::array<bool, NUM_SEATS> passChosen = {false, false, false, false};
+        std::array<bool, NUM_SEATS> waiting = {false, false, false, false};  // Request out to an engine
+        std::uint8_t plays[CARD_COUNT] = {};
+        std::uint8_t playSeats[CARD_COUNT] = {};
+        int playCount = 0;
+    };
+
+    struct Request {
+        Match* match;
+        int seat;
+        bool pass;
+        int roundNumber;
+        int ply;
+        Clock::time_point sent;
+        Clock::time_point deadline;
+    };
+
+    void startMatch(Match& match, int index);
+    void startRound(Match& match);
+    void advance(Match& match);
+    void applyPass(Match& match);
+    void applyPlay(Match& match, int card);
+    void endRound(Match& match);
+    void finishMatch(Match& match);
+
+    void request(Match& match, int seat, bool pass);
+    void answer(int id, const BotReply* reply);  // nullptr: timed out or engine gone
+    void pumpEngines(bool block);  // Flush requests, read replies, expire late ones
+
+    Options m_options;
+    std::vector<Participant> m_participants;
+    std::vector<std::unique_ptr<EngineProcess>> m_engines;
+    std::vector<int> m_engineQueue;  // Requests outstanding per engine
+
+    std::vector<std::unique_ptr<Match>> m_active;
+    int m_nextMatch = 0;
+    int m_finished = 0;
+    const RoundEngine* m_engine;
+
+    std::unordered_map<int, Request> m_requests;
+    int m_nextRequest = 1;
+
+    GameRecordWriter m_records;
+    Clock::time_point m_started;
+    double m_elapsedSeconds = 0;
+};
+
+#endif // SIM_SIMULATOR_H
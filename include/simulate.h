@@ -0,0 +1,125 @@
+#ifndef SIMULATE_H
+#define SIMULATE_H
+
+#include "alloccounter.h"
+#include "gamestate.h"
+#include "rng.h"
+#include <cassert>
+
+// Allocation-free round simulation for rollouts and tournaments. Everything
+// lives on the stack: the GameState core, bitboard move generation and
+// policy functors called as `int policy(const GameState& state, CardSet legal)`
+// for state.currentPlayer(). No Player, QVector or QString is involved.
+
+struct RoundOutcome {
+    std::int16_t points[GameState::NUM_PLAYERS];  // Points taken this round
+    std::int16_t totals[GameState::NUM_PLAYERS];  // Match totals after scoring
+    int moonShooter;                              // -1 if nobody shot the moon
+};
+
+// Plays `state` to the end of the round under rule set R
+template <typename R, typename Policy>
+GameState playOutRoundFor(GameState state, Policy& policy) {
+    while (!state.roundComplete()) {
+        state = applyMoveFor<R>(state, policy(state, legalMoves(state)));
+        if (state.trickComplete()) state = collectTrick(state);
+    }
+    return state;
+}
+
+// Deals `deal` (hands after any passing) into a fresh match and plays the
+// round out, scoring it under `rules`. The rule set is resolved once per
+// round. Debug builds assert the whole round stays off the heap.
+template <typename Policy>
+RoundOutcome simulateRound(const Hands& deal, Policy&& policy, const GameRules& rules) {
+#ifndef NDEBUG
+    std::uint64_t allocations = heapAllocationCount();
+#endif
+
+    RoundOutcome outcome;
+    dispatchRules(rules.flags(), [&](auto r) {
+        using R = decltype(r);
+        GameState played = playOutRoundFor<R>(dealRound(initialState(rules), deal), policy);
+        for (int i = 0; i < GameState::NUM_PLAYERS; ++i) outcome.points[i] = played.roundScores[i];
+        GameState scored = scoreRoundFor<R>(played, &outcome.moonShooter);
+        for (int i = 0; i < GameState::NUM_PLAYERS; ++i) outcome.totals[i] = scored.totalScores[i];
+    });
+
+    assert(heapAllocationCount() == allocations && "simulateRound must not allocate");
+    return outcome;
+}
+
+// ============================================================================
+// POLICIES
+// ============================================================================
+
+// Uniformly random legal card
+struct RandomPolicy {
+    Rng rng;
+
+    explicit RandomPolicy(std::uint64_t seed) : rng(seed) {}
+
+    int operator()(const GameState&, CardSet legal) {
+        for (int skip = rng.below(cardCount(legal)); skip > 0; --skip) legal &= legal - 1;
+        return firstCard(legal);
+    }
+};
+
+// Lowest legal card in index order
+struct LowestCardPolicy {
+    int operator()(const GameState&, CardSet legal) const { return firstCard(legal); }
+};
+
+// Cheap card-sense: duck under the winning card when following, dump Q♠
+// and high hearts when void, lead the lowest rank.
+struct DuckPolicy {
+    int operator()(const GameState& s, CardSet legal) const {
+        if (s.trickSize == 0) {
+            int best = firstCard(legal);
+            for (CardSet rest = legal; rest; ) {
+                int card = popFirstCard(rest);
+                if (cardRankIndex(card) < cardRankIndex(best)) best = card;
+            }
+            return best;
+        }
+
+        CardSet suited = legal & suitMask(s.leadSuit);
+        if (suited) {
+            int winning = s.trick[0];
+            for (int i = 1; i < s.trickSize; ++i) {
+                if (cardSuit(s.trick[i]) == s.leadSuit && s.trick[i] > winning) winning = s.trick[i];
+            }
+            CardSet under = suited & (cardBit(winning) - 1);
+            return under ? lastCard(under) : firstCard(suited);
+        }
+
+        if (legal & cardBit(QUEEN_OF_SPADES)) return QUEEN_OF_SPADES;
+        if (legal & HEARTS_MASK) return lastCard(legal & HEARTS_MASK);
+        return lastCard(legal);
+    }
+};
+
+// A different policy for each seat
+template <typename P0, typename P1, typename P2, typename P3>
+struct SeatPolicies {
+    P0 seat0;
+    P1 seat1;
+    P2 seat2;
+    P3 seat3;
+
+    int operator()(const GameState& s, CardSet legal) {
+        switch (s.currentPlayer()) {
+            case 0:  return seat0(s, legal);
+            case 1:  return seat1(s, legal);
+            case 2:  return seat2(s, legal);
+            default: return seat3(s, legal);
+        }
+    }
+};
+
+template <typename P0, typename P1, typename P2, typename P3>
+SeatPolicies<P0, P1, P2, P3> seatPolicies(P0 p0, P1 p1, P2 p2, P3 p3) {
+    return {p0, p1, p2, p3};
+}
+
+#endif // SIMULATE_H
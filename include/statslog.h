@@ -0,0 +1,108 @@
+#ifndef STATSLOG_H
+#define STATSLOG_H
+
+#include <QString>
+#include <array>
+#include <cstdint>
+
+// Per-match statistics history.
+//
+// stats.log is append-only: a 16-byte header, then one fixed-size
+// MatchStatsRecord per finished match, each with its own CRC so a torn
+// tail is detected and cut off. stats.agg holds the running aggregates and
+// the number of log records folded into them; it's rewritten atomically
+// after every append, so opening the Statistics dialog never reads the log.
+// If the snapshot is missing or behind, the missing records are folded in
+// on load.
+//
+// Counters from the old settings-based statistics enter the log once, as a
+// single import record, so the aggregate stays a pure fold of the log.
+
+// One finished match: 192 bytes
+struct MatchStatsRecord {
+    static const int MAX_ROUNDS = 36;
+
+    enum Kind : std::uint8_t {
+        Match = 0,
+        // Legacy totals: seed = games | wins << 32, finishedAt = total
+        // score, matchId = moon shots, endScore = best score
+        Import = 1
+    };
+
+    std::uint64_t seed;
+    std::int64_t finishedAt;          // ms since the epoch
+    std::uint32_t durationSecs;       // Wall-clock time in this session
+    std::uint32_t matchId;
+    std::uint8_t rules;               // RuleFlag bits
+    std::uint8_t difficulty;          // AIDifficulty
+    std::uint8_t winner;
+    std::uint8_t roundCount;
+    std::int16_t endScore;
+    std::int16_t finalScores[4];
+    std::uint8_t moonShots[4];        // Per seat
+    std::uint8_t kind;                // Match or Import
+    std::uint8_t reserved;
+    std::uint32_t crc;                // Of everything above and below, with crc = 0
+    std::int8_t roundScores[MAX_ROUNDS][4];  // Rounds before a resume are unknown (0)
+};
+
+static_assert(sizeof(MatchStatsRecord) == 192, "MatchStatsRecord is an on-disk format");
+
+// Running totals over all records, South's point of view. Scores are small
+// bounded integers, so the percentile sketch is an exact histogram with
+// clamped end bins: constant size and O(1) updates.
+struct StatsAggregate {
+    static const int SCORE_MIN = -128;
+    static const int SCORE_BINS = 512;
+    static const int DIFFICULTIES = 3;
+
+    quint64 records = 0;        // Log records folded in
+    quint32 imports = 0;        // Import records among them
+    quint32 games = 0;
+    quint32 wins = 0;
+    quint32 moons = 0;          // Moon shots by anyone
+    qint64 totalScore = 0;
+    qint32 bestScore = 999;
+    quint64 totalDurationSecs = 0;
+    std::array<quint32, DIFFICULTIES> gamesByDifficulty = {};
+    std::array<quint32, DIFFICULTIES> winsByDifficulty = {};
+    std::array<quint32, SCORE_BINS> scoreHistogram = {};
+
+    void add(const MatchStatsRecord& record);
+
+    double meanScore() const { return games ? static_cast<double>(totalScore) / games : 0; }
+    double winRate(int difficulty) const;  // Percent; -1 if no games at that level
+
+    // Smallest score s with at least `p` of the histogrammed games scoring <= s
+    int scorePercentile(double p) const;
+};
+
+class StatsLog {
+public:
+    explicit StatsLog(const QString& dir = defaultDir());
+
+    static QString defaultDir();
+
+    const StatsAggregate& aggregate() const { return m_aggregate; }
+
+    void append(MatchStatsRecord record);
+
+    // Counters carried over from settings-based statistics (no history),
+    // appended as an import record unless the log already holds one
+    bool hasImported() const { return m_aggregate.imports > 0; }
+    void importTotals(int games, int wins, int totalScore, int bestScore, int moons);
+
+    // Delete the history and start over
+    void reset();
+
+private:
+    void catchUp();
+    bool loadSnapshot();
+    void saveSnapshot() const;
+
+    QString m_logPath;
+    QString m_snapshotPath;
+    StatsAggregate m_aggregate;
+};
+
+#endif // STATSLOG_H
@@ -0,0 +1,81 @@
+#ifndef TRICKMODEL_H
+#define TRICKMODEL_H
+
+#include "gamestate.h"
+#include "gameclock.h"
+#include <QAbstractListModel>
+#include <QVector>
+#include <QtQml/qqmlregistration.h>
+
+// Cards on the table as a list model. Rows are appended as cards are played
+// and marked Exiting when the trick is collected; exiting rows are removed
+// once their animation has had time to finish. Rows of a collected trick
+// can overlap the first cards of the next one.
+class TrickModel : public QAbstractListModel {
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Owned by gameBridge")
+
+public:
+    enum AnimationPhase {
+        Placed,    // Already on the table; no animation
+        Entering,  // Flying in from its player
+        Exiting    // Flying out to the trick's winner
+    };
+    Q_ENUM(AnimationPhase)
+
+    enum Role {
+        PlayerRole = Qt::UserRole + 1,
+        SuitRole,
+        RankRole,
+        ElementIdRole,
+        RotationRole,
+        AnimationPhaseRole,
+        WinnerRole
+    };
+
+    static const int EXIT_DURATION = 250;  // ms (at normal speed) an exiting row stays in the model
+
+    explicit TrickModel(GameClock* clock, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Give each card a small random tilt
+    void setRotationEnabled(bool enabled) { m_rotationEnabled = enabled; }
+
+    // `player` played `card`; it flies in
+    void play(int player, int card);
+
+    // The trick on the table goes to `winner`
+    void collect(int winner);
+
+    // Match the cards on the table to `state`'s trick, keeping rows that
+    // already agree and placing the rest without animation (undo, resume,
+    // replay seek)
+    void setTrick(const GameState& state);
+
+    // Drop everything, exiting rows included
+    void clear();
+
+private:
+    struct Row {
+        quint8 player;
+        quint8 card;
+        qint8 rotation;
+        quint8 phase;
+        qint8 winner;
+    };
+
+    void append(int player, int card, AnimationPhase phase);
+    void removeExited(int count);
+
+    GameClock* m_clock;
+    QVector<Row> m_rows;
+    int m_exiting = 0;  // Leading rows in the Exiting phase
+    int m_generation = 0;
+    bool m_rotationEnabled = true;
+};
+
+#endif // TRICKMODEL_H
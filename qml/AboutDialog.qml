@@ -0,0 +1,55 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// About dialog; loaded by Main.qml on first open
+Item {
+    function open() { aboutDialog.open() }
+
+    Dialog {
+        id: aboutDialog
+        title: qsTr("About Hearts")
+        standardButtons: Dialog.Ok
+        anchors.centerIn: parent
+        width: 400
+        modal: true
+
+        ColumnLayout {
+            spacing: 10
+            anchors.fill: parent
+
+            Label {
+                text: qsTr("Hearts")
+                font.pixelSize: 24
+                font.bold: true
+                Layout.alignment: Qt.AlignHCenter
+            }
+            Label {
+                text: qsTr("A classic card game for Qt.")
+                Layout.alignment: Qt.AlignHCenter
+            }
+            Label {
+                text: qsTr("Try to avoid taking hearts and especially the Queen of Spades!")
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+                horizontalAlignment: Text.AlignHCenter
+            }
+            Label {
+                text: qsTr("<b>Rules:</b><ul>" +
+                    "<li>Each heart is worth 1 point</li>" +
+                    "<li>Queen of Spades is worth 13 points</li>" +
+                    "<li>Lowest score wins</li>" +
+                    "<li>\"Shoot the Moon\" - take all hearts and QoS to give 26 points to others</li>" +
+                    "</ul>")
+                textFormat: Text.RichText
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+            }
+            Label {
+                text: qsTr("Version 1.0")
+                Layout.alignment: Qt.AlignHCenter
+                color: "#888888"
+            }
+        }
+    }
+}
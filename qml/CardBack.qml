@@ -1,4 +1,5 @@
 import QtQuick
+import Hearts
 
 Item {
     id: cardBack
@@ -9,15 +10,12 @@ Item {
     width: cardWidth + 4
     height: cardHeight + 4
 
-    Image {
+    CardImage {
         anchors.centerIn: parent
         width: cardWidth
         height: cardHeight
-        source: "image://cards/back?v=" + gameBridge.themeVersion
-        sourceSize.width: Math.round(cardWidth)
-        sourceSize.height: Math.round(cardHeight)
-        smooth: true
+        atlas: gameBridge.cardAtlas
+        faceUp: false
         antialiasing: true
-        cache: true
     }
 }
@@ -0,0 +1,65 @@
+import QtQuick
+import Hearts
+
+// Card drawing bench, loaded instead of Main.qml by `qt-hearts --bench-cards`:
+// all 52 cards keep moving, turning, fading and changing highlight while
+// PerfMonitor records, so frame times can be compared between CardItem and
+// LegacyCardItem (`--bench-cards legacy`). main.cpp ends the run.
+Rectangle {
+    id: bench
+    anchors.fill: parent
+    color: "#0b5d2e"
+
+    readonly property real cardWidth: Math.min(width / 14, height / 6)
+    readonly property real cardHeight: cardWidth * 1.45
+    property int step: 0
+
+    // Faster than the 180 ms moves, so every card is always in flight
+    Timer {
+        interval: 150
+        running: true
+        repeat: true
+        onTriggered: bench.step++
+    }
+
+    function cardX(index) {
+        return ((index + step) % 13) * width / 13 + (step % 2 ? cardWidth / 4 : 0)
+    }
+    function cardY(index) {
+        return Math.floor(index / 13) * height / 4 + (step % 2 ? 0 : cardHeight / 8)
+    }
+
+    Repeater {
+        model: benchLegacy ? 0 : 52
+        delegate: CardItem {
+            x: bench.cardX(index)
+            y: bench.cardY(index)
+            rotation: ((index + bench.step) % 5 - 2) * 6
+            opacity: (index + bench.step) % 9 === 0 ? 0.6 : 1
+            cardWidth: bench.cardWidth
+            cardHeight: bench.cardHeight
+            suit: Math.floor(index / 13)
+            rank: index % 13 + 2
+            faceUp: (index + bench.step) % 7 !== 0
+            playable: (index + bench.step) % 3 === 0
+            selected: (index + bench.step) % 11 === 0
+        }
+    }
+
+    Repeater {
+        model: benchLegacy ? 52 : 0
+        delegate: LegacyCardItem {
+            x: bench.cardX(index)
+            y: bench.cardY(index)
+            rotation: ((index + bench.step) % 5 - 2) * 6
+            opacity: (index + bench.step) % 9 === 0 ? 0.6 : 1
+            cardWidth: bench.cardWidth
+            cardHeight: bench.cardHeight
+            suit: Math.floor(index / 13)
+            rank: index % 13 + 2
+            faceUp: (index + bench.step) % 7 !== 0
+            playable: (index + bench.step) % 3 === 0
+            selected: (index + bench.step) % 11 === 0
+        }
+    }
+}
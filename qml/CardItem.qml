@@ -1,4 +1,5 @@
 import QtQuick
+import Hearts
 
 Item {
     id: cardItem
@@ -20,104 +21,67 @@ Item {
     width: cardWidth + 4
     height: cardHeight + 4
 
+    // Animators run on the render thread, so a busy GUI thread (AI turns,
+    // model updates) doesn't stall cards in flight
     Behavior on x {
         enabled: enableBehaviors
-        NumberAnimation {
-            duration: 180
+        XAnimator {
+            duration: 180 * gameBridge.animationScale
             easing.type: Easing.OutQuad
         }
     }
 
     Behavior on y {
         enabled: enableBehaviors
-        NumberAnimation {
-            duration: 180
+        YAnimator {
+            duration: 180 * gameBridge.animationScale
             easing.type: Easing.OutQuad
         }
     }
 
     Behavior on rotation {
         enabled: enableBehaviors
-        NumberAnimation {
-            duration: 180
+        RotationAnimator {
+            duration: 180 * gameBridge.animationScale
             easing.type: Easing.OutQuad
         }
     }
 
     Behavior on opacity {
         enabled: enableBehaviors
-        NumberAnimation {
-            duration: 150
+        OpacityAnimator {
+            duration: 150 * gameBridge.animationScale
             easing.type: Easing.OutQuad
         }
     }
 
-    // Card visual container
-    Item {
+    // Shadow, face or back, dimming and highlight border in one scene-graph node
+    CardQuickItem {
         id: cardVisual
-        anchors.centerIn: parent
+        x: 2
+        y: 2 - (selected ? 15 : (((hoverArea.containsMouse || keyboardFocused) && playable) ? 8 : 0))
         width: cardWidth
         height: cardHeight
-
-        transform: Translate {
-            id: raiseTranslate
-            y: selected ? -15 : (((hoverArea.containsMouse || keyboardFocused) && playable) ? -8 : 0)
-
-            Behavior on y {
-                NumberAnimation {
-                    duration: 100
-                    easing.type: Easing.OutQuad
-                }
-            }
-        }
-
-        Image {
-            id: cardImage
-            anchors.fill: parent
-            source: faceUp ? "image://cards/" + elementId + "?v=" + gameBridge.themeVersion
-                           : "image://cards/back?v=" + gameBridge.themeVersion
-            sourceSize.width: Math.round(cardWidth)
-            sourceSize.height: Math.round(cardHeight)
-            smooth: true
-            antialiasing: true
-            cache: true
-            asynchronous: false
-        }
-
-        // Highlight border
-        Rectangle {
-            anchors.centerIn: parent
-            width: cardWidth + 2
-            height: cardHeight + 2
-            radius: 6
-            antialiasing: true
-            color: "transparent"
-            border.width: 2
-            border.color: {
-                if (received) return "#ffc832"
-                if (selected) return "#3296ff"
-                if (keyboardFocused && playable) return "#ffdc64"
-                if (hoverArea.containsMouse && playable) return "#64c864"
-                return "transparent"
-            }
-            visible: received || selected || ((hoverArea.containsMouse || keyboardFocused) && playable)
-
-            Behavior on border.color {
-                ColorAnimation { duration: 100 }
-            }
+        atlas: gameBridge.cardAtlas
+        suit: cardItem.suit
+        rank: cardItem.rank
+        faceUp: cardItem.faceUp
+
+        borderColor: {
+            if (received) return "#ffc832"
+            if (selected) return "#3296ff"
+            if (keyboardFocused && playable) return "#ffdc64"
+            if (hoverArea.containsMouse && playable) return "#64c864"
+            return "transparent"
         }
 
         // Dim non-playable cards
-        Rectangle {
-            anchors.fill: parent
-            radius: 6
-            antialiasing: true
-            color: "#000000"
-            opacity: (!playable && faceUp && !inTrick && !received) ? 0.235 : 0
-            visible: opacity > 0
+        tintColor: (!playable && faceUp && !inTrick && !received) ? "#3c000000" : "transparent"
 
-            Behavior on opacity {
-                NumberAnimation { duration: 100 }
+        Behavior on y {
+            YAnimator {
+                duration: 100 * gameBridge.animationScale
+                easing.type: Easing.OutQuad
             }
         }
     }
@@ -129,6 +129,15 @@ Item {
         visible: gameBridge.passDirection < 3 && gameBridge.gameState === 3 // WaitingForPass
     }
 
+    // Replay controls
+    ReplayBar {
+        id: replayBar
+        z: 600
+        x: 20
+        y: 20
+        visible: gameBridge.replayActive
+    }
+
     // Message banner
     MessageBanner {
         id: messageBanner
@@ -190,21 +199,15 @@ Item {
                 var startPos = receivedCardsOverlay.opponentPosition()
                 var startRot = receivedCardsOverlay.opponentRotation()
 
-                var handCards = gameBridge.playerHand
-                var handCount = handCards ? handCards.length : 0
+                var handModel = gameBridge.handModel
 
                 for (var i = 0; i < cards.length; i++) {
                     var c = cards[i]
 
                     var component = Qt.createComponent("CardItem.qml")
                     if (component.status === Component.Ready) {
-                        var handIndex = Math.floor(handCount / 2)
-                        for (var k = 0; k < handCount; k++) {
-                            if (handCards[k].suit === c.suit && handCards[k].rank === c.rank) {
-                                handIndex = k
-                                break
-                            }
-                        }
+                        var handIndex = handModel.indexOf(c.suit, c.rank)
+                        if (handIndex < 0) handIndex = Math.floor(handModel.count / 2)
 
                         var targetX = playerHand.x + handIndex * gameBoard.cardSpacing
                         var targetY = playerHand.y
@@ -235,7 +238,7 @@ Item {
                     }
                 }
 
-                clearAnimTimer.interval = 350
+                clearAnimTimer.interval = 350 * gameBridge.animationScale
                 clearAnimTimer.start()
             }
         }
@@ -260,17 +263,17 @@ Item {
                     running: true
                     NumberAnimation {
                         target: animCtrl.parent; property: "x"
-                        to: animCtrl.targetX; duration: 280
+                        to: animCtrl.targetX; duration: 280 * gameBridge.animationScale
                         easing.type: Easing.OutCubic
                     }
                     NumberAnimation {
                         target: animCtrl.parent; property: "y"
-                        to: animCtrl.targetY; duration: 280
+                        to: animCtrl.targetY; duration: 280 * gameBridge.animationScale
                         easing.type: Easing.OutCubic
                     }
                     NumberAnimation {
                         target: animCtrl.parent; property: "rotation"
-                        to: 0; duration: 280
+                        to: 0; duration: 280 * gameBridge.animationScale
                         easing.type: Easing.OutCubic
                     }
                 }
@@ -278,10 +281,10 @@ Item {
                 // Crossfade flip
                 SequentialAnimation {
                     running: true
-                    PauseAnimation { duration: 100 }
+                    PauseAnimation { duration: 100 * gameBridge.animationScale }
                     NumberAnimation {
                         target: animCtrl.parent; property: "opacity"
-                        to: 0; duration: 60
+                        to: 0; duration: 60 * gameBridge.animationScale
                         easing.type: Easing.InQuad
                     }
                     ScriptAction {
@@ -289,7 +292,7 @@ Item {
                     }
                     NumberAnimation {
                         target: animCtrl.parent; property: "opacity"
-                        to: 1.0; duration: 60
+                        to: 1.0; duration: 60 * gameBridge.animationScale
                         easing.type: Easing.OutQuad
                     }
                 }
@@ -297,6 +300,97 @@ Item {
         }
     }
 
+    // Performance HUD (F3): frame, scene-graph and latency percentiles
+    Rectangle {
+        id: perfHud
+
+        property string lastDump: ""
+
+        function pad(value, width) {
+            var s = String(value)
+            while (s.length < width) s = " " + s
+            return s
+        }
+
+        function row(m) {
+            if (m.count === 0) return pad(m.name, 6) + pad(0, 6) + pad("-", 8) + pad("-", 8) + pad("-", 8) + pad("-", 8)
+            return pad(m.name, 6) + pad(m.count, 6) + pad(m.p50.toFixed(2), 8) + pad(m.p95.toFixed(2), 8)
+                   + pad(m.p99.toFixed(2), 8) + pad(m.max.toFixed(2), 8)
+        }
+
+        visible: gameBridge.perfMonitor.enabled
+        anchors.horizontalCenter: parent.horizontalCenter
+        y: 10
+        z: 1000
+        width: perfColumn.width + 16
+        height: perfColumn.height + 16
+        radius: 4
+        color: "#c0000000"
+
+        Column {
+            id: perfColumn
+            x: 8
+            y: 8
+            spacing: 2
+
+            Text {
+                color: "#a0ffa0"
+                font.family: "monospace"
+                font.pixelSize: 11
+                text: perfHud.pad("metric", 6) + perfHud.pad("n", 6) + perfHud.pad("p50", 8) + perfHud.pad("p95", 8)
+                      + perfHud.pad("p99", 8) + perfHud.pad("max", 8) + "  ms"
+            }
+            Repeater {
+                model: gameBridge.perfMonitor.summary
+                Text {
+                    color: "white"
+                    font.family: "monospace"
+                    font.pixelSize: 11
+                    text: perfHud.row(modelData)
+                }
+            }
+            Text {
+                visible: gameBridge.perfMonitor.startupMs >= 0
+                color: "white"
+                font.family: "monospace"
+                font.pixelSize: 11
+                text: qsTr("first frame after %1 ms").arg(gameBridge.perfMonitor.startupMs)
+            }
+            Text {
+                readonly property var cache: gameBridge.perfMonitor.cardCache
+                visible: cache.images !== undefined
+                color: "white"
+                font.family: "monospace"
+                font.pixelSize: 11
+                text: qsTr("card cache %1 images, %2 / %3 MB, %4 hits %5 misses")
+                      .arg(cache.images).arg((cache.bytes / 1048576).toFixed(1)).arg(Math.round(cache.budget / 1048576))
+                      .arg(cache.hits).arg(cache.misses)
+            }
+            Row {
+                spacing: 6
+                Button {
+                    text: qsTr("Save CSV")
+                    onClicked: perfHud.lastDump = gameBridge.perfMonitor.dumpCsv() || qsTr("Could not write the trace")
+                }
+                Button {
+                    text: qsTr("Reset")
+                    onClicked: gameBridge.perfMonitor.reset()
+                }
+            }
+            Text {
+                visible: perfHud.lastDump !== ""
+                color: "white"
+                font.pixelSize: 11
+                text: perfHud.lastDump
+            }
+        }
+    }
+
+    Shortcut {
+        sequence: "F3"
+        onActivated: gameBridge.perfMonitor.enabled = !gameBridge.perfMonitor.enabled
+    }
+
     // Card navigation keyboard shortcuts
     Shortcut {
         sequence: "Left"
@@ -18,7 +18,7 @@ Rectangle {
     opacity: visible ? 1 : 0
 
     Behavior on opacity {
-        NumberAnimation { duration: 300 }
+        NumberAnimation { duration: 300 * gameBridge.animationScale }
     }
 
     Column {
@@ -0,0 +1,140 @@
+import QtQuick
+import Hearts
+
+// CardItem as it was before CardQuickItem: an atlas CardImage with border and
+// dim Rectangles on top, animated on the GUI thread. Kept only so
+// CardBench.qml can measure the old composition against the current one;
+// durations follow animationScale like CardItem's so both run the same motion.
+Item {
+    id: cardItem
+
+    property int suit: 0
+    property int rank: 0
+    property string elementId: ""
+    property bool faceUp: true
+    property bool playable: false
+    property bool selected: false
+    property bool received: false
+    property bool inTrick: false
+    property bool keyboardFocused: false
+    property real cardWidth: 80
+    property real cardHeight: 116
+
+    property bool enableBehaviors: true
+
+    width: cardWidth + 4
+    height: cardHeight + 4
+
+    Behavior on x {
+        enabled: enableBehaviors
+        NumberAnimation {
+            duration: 180 * gameBridge.animationScale
+            easing.type: Easing.OutQuad
+        }
+    }
+
+    Behavior on y {
+        enabled: enableBehaviors
+        NumberAnimation {
+            duration: 180 * gameBridge.animationScale
+            easing.type: Easing.OutQuad
+        }
+    }
+
+    Behavior on rotation {
+        enabled: enableBehaviors
+        NumberAnimation {
+            duration: 180 * gameBridge.animationScale
+            easing.type: Easing.OutQuad
+        }
+    }
+
+    Behavior on opacity {
+        enabled: enableBehaviors
+        NumberAnimation {
+            duration: 150 * gameBridge.animationScale
+            easing.type: Easing.OutQuad
+        }
+    }
+
+    // Card visual container
+    Item {
+        id: cardVisual
+        anchors.centerIn: parent
+        width: cardWidth
+        height: cardHeight
+
+        transform: Translate {
+            id: raiseTranslate
+            y: selected ? -15 : (((hoverArea.containsMouse || keyboardFocused) && playable) ? -8 : 0)
+
+            Behavior on y {
+                NumberAnimation {
+                    duration: 100 * gameBridge.animationScale
+                    easing.type: Easing.OutQuad
+                }
+            }
+        }
+
+        // Sampled from the shared card atlas: one texture for every card
+        CardImage {
+            id: cardImage
+            anchors.fill: parent
+            atlas: gameBridge.cardAtlas
+            suit: cardItem.suit
+            rank: cardItem.rank
+            faceUp: cardItem.faceUp
+            antialiasing: true
+        }
+
+        // Highlight border
+        Rectangle {
+            anchors.centerIn: parent
+            width: cardWidth + 2
+            height: cardHeight + 2
+            radius: 6
+            antialiasing: true
+            color: "transparent"
+            border.width: 2
+            border.color: {
+                if (received) return "#ffc832"
+                if (selected) return "#3296ff"
+                if (keyboardFocused && playable) return "#ffdc64"
+                if (hoverArea.containsMouse && playable) return "#64c864"
+                return "transparent"
+            }
+            visible: received || selected || ((hoverArea.containsMouse || keyboardFocused) && playable)
+
+            Behavior on border.color {
+                ColorAnimation { duration: 100 * gameBridge.animationScale }
+            }
+        }
+
+        // Dim non-playable cards
+        Rectangle {
+            anchors.fill: parent
+            radius: 6
+            antialiasing: true
+            color: "#000000"
+            opacity: (!playable && faceUp && !inTrick && !received) ? 0.235 : 0
+            visible: opacity > 0
+
+            Behavior on opacity {
+                NumberAnimation { duration: 100 * gameBridge.animationScale }
+            }
+        }
+    }
+
+    MouseArea {
+        id: hoverArea
+        anchors.fill: parent
+        hoverEnabled: true
+        cursorShape: playable ? Qt.PointingHandCursor : Qt.ArrowCursor
+
+        onClicked: {
+            if (playable) {
+                gameBridge.cardClicked(suit, rank)
+            }
+        }
+    }
+}
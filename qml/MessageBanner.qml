@@ -13,7 +13,7 @@ Rectangle {
     opacity: visible ? 1 : 0
 
     Behavior on opacity {
-        NumberAnimation { duration: 150 }
+        NumberAnimation { duration: 150 * gameBridge.animationScale }
     }
 
     Text {
@@ -12,6 +12,21 @@ Item {
     // West (1): vertical, cards rotated 90°
     // North (2): horizontal, cards rotated 180°
     // East (3): vertical, cards rotated -90°
+    readonly property int cardRotation: {
+        if (playerIndex === 1) return 90
+        if (playerIndex === 2) return 180
+        if (playerIndex === 3) return -90
+        return 0
+    }
+
+    // While a played card leaves, or the sprite for a new count is still
+    // rendering, the hand is drawn card by card; otherwise it is a single
+    // sprite rendered by CardTheme
+    readonly property bool perCard: leaveAnimation.running || fanSprite.status !== Image.Ready
+    property int leaveFrom: 0
+    property real leaveProgress: 0
+    property int lastCount: 0
+
     width: {
         if (playerIndex === 2)
             return cardCount > 0 ? (cardCount - 1) * cardSpacing + cardWidth + 4 : 0
@@ -25,29 +40,59 @@ Item {
             return cardCount > 0 ? (cardCount - 1) * cardSpacing + cardWidth + 4 : 0
     }
 
+    onCardCountChanged: {
+        if (lastCount - cardCount === 1) {
+            leaveFrom = lastCount
+            leaveAnimation.restart()
+        }
+        lastCount = cardCount
+    }
+
+    NumberAnimation {
+        id: leaveAnimation
+        target: opponentHand
+        property: "leaveProgress"
+        from: 0
+        to: 1
+        duration: 150 * gameBridge.animationScale
+        easing.type: Easing.OutQuad
+        onFinished: opponentHand.leaveFrom = 0
+    }
+
+    Image {
+        id: fanSprite
+        anchors.fill: parent
+        visible: !opponentHand.perCard
+        source: opponentHand.cardCount > 0
+                ? "image://cards/fan/" + opponentHand.cardCount + "/" + opponentHand.cardRotation + "/"
+                  + Math.round(opponentHand.cardWidth) + "x" + Math.round(opponentHand.cardHeight) + "/"
+                  + Math.round(opponentHand.cardSpacing) + "?v=" + gameBridge.themeVersion
+                : ""
+        smooth: true
+    }
+
     Repeater {
-        model: cardCount
+        model: opponentHand.perCard ? Math.max(opponentHand.leaveFrom, opponentHand.cardCount) : 0
 
         CardBack {
+            readonly property bool leaving: index >= opponentHand.cardCount
+            // The leaving card slides toward the table as it fades
+            readonly property real slide: leaving ? opponentHand.leaveProgress * opponentHand.cardHeight * 0.5 : 0
+
             cardWidth: opponentHand.cardWidth
             cardHeight: opponentHand.cardHeight
             transformOrigin: Item.TopLeft
+            rotation: opponentHand.cardRotation
             z: index
-
-            rotation: {
-                if (opponentHand.playerIndex === 1) return 90
-                if (opponentHand.playerIndex === 2) return 180
-                if (opponentHand.playerIndex === 3) return -90
-                return 0
-            }
+            opacity: leaving ? 1 - opponentHand.leaveProgress : 1
 
             x: {
                 if (opponentHand.playerIndex === 1)
-                    return opponentHand.cardHeight + 4
+                    return opponentHand.cardHeight + 4 + slide
                 if (opponentHand.playerIndex === 2)
                     return index * opponentHand.cardSpacing + opponentHand.cardWidth + 4
                 if (opponentHand.playerIndex === 3)
-                    return 0
+                    return -slide
                 return index * opponentHand.cardSpacing
             }
 
@@ -55,25 +100,11 @@ Item {
                 if (opponentHand.playerIndex === 1)
                     return index * opponentHand.cardSpacing
                 if (opponentHand.playerIndex === 2)
-                    return opponentHand.cardHeight + 4
+                    return opponentHand.cardHeight + 4 + slide
                 if (opponentHand.playerIndex === 3)
                     return index * opponentHand.cardSpacing + opponentHand.cardWidth + 4
                 return 0
             }
-
-            Behavior on x {
-                NumberAnimation {
-                    duration: 150
-                    easing.type: Easing.OutQuad
-                }
-            }
-
-            Behavior on y {
-                NumberAnimation {
-                    duration: 150
-                    easing.type: Easing.OutQuad
-                }
-            }
         }
     }
 }
@@ -21,6 +21,6 @@ Text {
     opacity: visible ? 1 : 0
 
     Behavior on opacity {
-        NumberAnimation { duration: 200 }
+        NumberAnimation { duration: 200 * gameBridge.animationScale }
     }
 }
@@ -7,8 +7,7 @@ Item {
     property real cardHeight: 116
     property real cardSpacing: 22
 
-    property var cards: gameBridge.playerHand
-    property int cardCount: cards ? cards.length : 0
+    property int cardCount: gameBridge.handModel.count
 
     // Track keyboard focus
     property int keyboardFocusIndex: -1
@@ -59,9 +58,9 @@ Item {
 
     function selectFocused() {
         if (keyboardFocusIndex >= 0 && keyboardFocusIndex < cardCount) {
-            var cardData = cards[keyboardFocusIndex]
-            if (cardData.playable) {
-                gameBridge.cardClicked(cardData.suit, cardData.rank)
+            var card = handRepeater.itemAt(keyboardFocusIndex)
+            if (card && card.playable) {
+                gameBridge.cardClicked(card.suit, card.rank)
             }
         }
     }
@@ -74,19 +73,20 @@ Item {
         if (cardCount > 0) keyboardFocusIndex = cardCount - 1
     }
 
+    // Rows are inserted, removed and updated in place by the hand model,
+    // so a card's delegate lives as long as the card stays in the hand
     Repeater {
-        model: cards
+        id: handRepeater
+        model: gameBridge.handModel
 
         CardItem {
-            property var cardData: modelData
-
-            suit: cardData.suit
-            rank: cardData.rank
-            elementId: cardData.elementId
+            suit: model.suit
+            rank: model.rank
+            elementId: model.elementId
             faceUp: true
-            playable: cardData.playable
-            selected: cardData.selected
-            received: cardData.received
+            playable: model.playable
+            selected: model.selected
+            received: model.received
             keyboardFocused: index === playerHand.keyboardFocusIndex
             cardWidth: playerHand.cardWidth
             cardHeight: playerHand.cardHeight
@@ -106,7 +106,7 @@ Item {
 
                     Behavior on y {
                         NumberAnimation {
-                            duration: 80
+                            duration: 80 * gameBridge.animationScale
                             easing.type: Easing.OutQuad
                         }
                     }
@@ -118,7 +118,7 @@ Item {
 
                     Behavior on angle {
                         NumberAnimation {
-                            duration: 80
+                            duration: 80 * gameBridge.animationScale
                             easing.type: Easing.OutQuad
                         }
                     }
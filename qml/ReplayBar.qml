@@ -0,0 +1,129 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+Rectangle {
+    id: replayBar
+
+    width: 300
+    height: content.implicitHeight + 20
+    radius: 4
+    color: "#dc1e1e1e"
+    border.color: "#505050"
+    border.width: 1
+
+    ColumnLayout {
+        id: content
+        anchors.fill: parent
+        anchors.margins: 10
+        spacing: 6
+
+        RowLayout {
+            Layout.fillWidth: true
+
+            Text {
+                text: qsTr("Replay")
+                color: "white"
+                font.pixelSize: 14
+                font.bold: true
+                Layout.fillWidth: true
+            }
+
+            Button {
+                text: qsTr("Close")
+                onClicked: gameBridge.closeReplay()
+            }
+        }
+
+        ComboBox {
+            id: matchBox
+            Layout.fillWidth: true
+            model: gameBridge.replayMatches
+            onActivated: function(index) { gameBridge.selectReplayMatch(index) }
+
+            Binding on currentIndex {
+                value: gameBridge.replayMatch
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+
+            Button {
+                text: "⏮"
+                enabled: gameBridge.replayRound > 0
+                onClicked: gameBridge.replaySeek(gameBridge.replayRound - 1, 0)
+            }
+
+            Text {
+                text: qsTr("Round %1 of %2").arg(gameBridge.replayRound + 1).arg(gameBridge.replayRoundCount)
+                color: "#ffdc50"
+                font.pixelSize: 13
+                font.bold: true
+                horizontalAlignment: Text.AlignHCenter
+                Layout.fillWidth: true
+            }
+
+            Button {
+                text: "⏭"
+                enabled: gameBridge.replayRound + 1 < gameBridge.replayRoundCount
+                onClicked: gameBridge.replaySeek(gameBridge.replayRound + 1, 0)
+            }
+        }
+
+        // Scrub by trick; 13 is the end of the round
+        Slider {
+            id: trickSlider
+            Layout.fillWidth: true
+            from: 0
+            to: 13
+            stepSize: 1
+            snapMode: Slider.SnapAlways
+            onMoved: gameBridge.replaySeek(gameBridge.replayRound, value)
+
+            Binding on value {
+                value: gameBridge.replayTrick
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+
+            Button {
+                text: "◀"
+                onClicked: gameBridge.replayStepBack()
+            }
+
+            Text {
+                text: gameBridge.replayTrick < 13
+                      ? qsTr("Trick %1 of 13").arg(gameBridge.replayTrick + 1)
+                      : qsTr("Round over")
+                color: "white"
+                font.pixelSize: 12
+                horizontalAlignment: Text.AlignHCenter
+                Layout.fillWidth: true
+            }
+
+            Button {
+                text: "▶"
+                onClicked: gameBridge.replayStepForward()
+            }
+        }
+    }
+
+    Shortcut {
+        sequence: "Left"
+        enabled: replayBar.visible
+        onActivated: gameBridge.replayStepBack()
+    }
+    Shortcut {
+        sequence: "Right"
+        enabled: replayBar.visible
+        onActivated: gameBridge.replayStepForward()
+    }
+    Shortcut {
+        sequence: "Escape"
+        enabled: replayBar.visible
+        onActivated: gameBridge.closeReplay()
+    }
+}
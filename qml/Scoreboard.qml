@@ -17,11 +17,11 @@ Rectangle {
     border.width: isCurrentPlayer ? 2 : 1
 
     Behavior on color {
-        ColorAnimation { duration: 200 }
+        ColorAnimation { duration: 200 * gameBridge.animationScale }
     }
 
     Behavior on border.color {
-        ColorAnimation { duration: 200 }
+        ColorAnimation { duration: 200 * gameBridge.animationScale }
     }
 
     Column {
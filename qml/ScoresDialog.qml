@@ -0,0 +1,40 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// Scores dialog; loaded by Main.qml on first open
+Item {
+    function open() { scoresDialog.open() }
+
+    Dialog {
+        id: scoresDialog
+        title: qsTr("Scores")
+        standardButtons: Dialog.Ok
+        anchors.centerIn: parent
+        width: 300
+        modal: true
+
+        ColumnLayout {
+            spacing: 10
+            anchors.fill: parent
+
+            Repeater {
+                model: gameBridge.players
+                delegate: RowLayout {
+                    Layout.fillWidth: true
+                    Label {
+                        text: modelData.name
+                        Layout.fillWidth: true
+                        font.bold: true
+                    }
+                    Label {
+                        text: modelData.score
+                        horizontalAlignment: Text.AlignRight
+                        font.bold: true
+                        color: "#ffdc50"
+                    }
+                }
+            }
+        }
+    }
+}
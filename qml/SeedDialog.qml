@@ -0,0 +1,73 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// Play Seed dialog; loaded by Main.qml on first open
+Item {
+    function open() {
+        seedField.text = ""
+        seedError.visible = false
+        seedDialog.open()
+    }
+
+    Dialog {
+        id: seedDialog
+        title: qsTr("Play Seed")
+        anchors.centerIn: parent
+        width: 340
+        modal: true
+
+        // Stay open on a bad seed so it can be corrected
+        function play() {
+            if (gameBridge.playSeed(seedField.text)) {
+                close()
+            } else {
+                seedError.visible = true
+            }
+        }
+
+        footer: DialogButtonBox {
+            Button {
+                text: qsTr("Play")
+                DialogButtonBox.buttonRole: DialogButtonBox.ApplyRole
+            }
+            Button {
+                text: qsTr("Cancel")
+                DialogButtonBox.buttonRole: DialogButtonBox.RejectRole
+            }
+            onApplied: seedDialog.play()
+            onRejected: seedDialog.close()
+        }
+
+        onOpened: seedField.forceActiveFocus()
+
+        ColumnLayout {
+            spacing: 8
+            anchors.fill: parent
+
+            Label {
+                text: qsTr("Same seed, same deals and same AI play.")
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+            }
+            TextField {
+                id: seedField
+                placeholderText: qsTr("Seed (decimal or 0x hex)")
+                selectByMouse: true
+                Layout.fillWidth: true
+                onAccepted: seedDialog.play()
+            }
+            Label {
+                id: seedError
+                text: qsTr("Not a valid seed")
+                color: "#ff6464"
+                visible: false
+            }
+            Label {
+                text: qsTr("Current match: %1").arg(gameBridge.matchSeed)
+                font.pixelSize: 11
+                color: "#888888"
+            }
+        }
+    }
+}
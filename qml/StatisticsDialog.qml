@@ -0,0 +1,108 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// Statistics dialog and its reset confirmation; loaded by Main.qml on first open
+Item {
+    function open() { statisticsDialog.open() }
+
+    Dialog {
+        id: statisticsDialog
+        title: qsTr("Statistics")
+        anchors.centerIn: parent
+        width: 380
+        modal: true
+
+        function winRateText(difficulty) {
+            var rate = gameBridge.difficultyWinRates[difficulty]
+            return rate >= 0 ? rate.toFixed(1) + "%" : "-"
+        }
+
+        footer: DialogButtonBox {
+            Button {
+                text: qsTr("Reset")
+                DialogButtonBox.buttonRole: DialogButtonBox.DestructiveRole
+                onClicked: resetConfirmDialog.open()
+            }
+            Button {
+                text: qsTr("OK")
+                DialogButtonBox.buttonRole: DialogButtonBox.AcceptRole
+            }
+            onAccepted: statisticsDialog.close()
+        }
+
+        ColumnLayout {
+            spacing: 8
+            anchors.fill: parent
+
+            Label {
+                text: qsTr("Lifetime Statistics")
+                font.pixelSize: 18
+                font.bold: true
+                Layout.alignment: Qt.AlignHCenter
+                Layout.bottomMargin: 10
+            }
+
+            GridLayout {
+                columns: 2
+                Layout.fillWidth: true
+                columnSpacing: 20
+                rowSpacing: 6
+
+                Label { text: qsTr("Games Played:") }
+                Label { text: gameBridge.gamesPlayed; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Games Won:") }
+                Label { text: gameBridge.gamesWon; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Win Rate:") }
+                Label { text: gameBridge.winRate.toFixed(1) + "%"; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Average Score:") }
+                Label { text: gameBridge.avgScore.toFixed(1); font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Best Score:") }
+                Label { text: gameBridge.bestScore >= 0 ? gameBridge.bestScore : "-"; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Shot the Moon:") }
+                Label { text: gameBridge.shootTheMoonCount; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Median Score:") }
+                Label { text: gameBridge.gamesPlayed > 0 ? gameBridge.medianScore : "-"; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("90th Percentile Score:") }
+                Label { text: gameBridge.gamesPlayed > 0 ? gameBridge.percentile90Score : "-"; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Average Match Length:") }
+                Label { text: gameBridge.avgMatchMinutes.toFixed(1) + " min"; font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Win Rate (Easy):") }
+                Label { text: winRateText(0); font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Win Rate (Medium):") }
+                Label { text: winRateText(1); font.bold: true; Layout.alignment: Qt.AlignRight }
+
+                Label { text: qsTr("Win Rate (Hard):") }
+                Label { text: winRateText(2); font.bold: true; Layout.alignment: Qt.AlignRight }
+            }
+        }
+    }
+
+    // Reset confirmation
+    Dialog {
+        id: resetConfirmDialog
+        title: qsTr("Reset Statistics")
+        standardButtons: Dialog.Yes | Dialog.No
+        anchors.centerIn: parent
+        modal: true
+
+        Label {
+            text: qsTr("Are you sure you want to reset all statistics?")
+        }
+
+        onAccepted: {
+            gameBridge.resetStatistics()
+            statisticsDialog.close()
+        }
+    }
+}
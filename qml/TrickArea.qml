@@ -1,4 +1,5 @@
 import QtQuick
+import Hearts
 
 Item {
     id: trickArea
@@ -6,9 +7,6 @@ Item {
     property real cardWidth: 80
     property real cardHeight: 116
 
-    property int expectedCardCount: 0
-    property var exitingCards: []
-
     width: cardWidth * 3
     height: cardHeight * 3
 
@@ -75,27 +73,34 @@ Item {
         return (height - cardHeight) / 2
     }
 
-    // --- Trick cards: ListModel + Repeater for reactive positioning ---
-
-    ListModel {
-        id: trickModel
-    }
+    // --- Trick cards: rows come and go with gameBridge.trickModel ---
+    // Entering rows fly in from their player, Placed rows appear in place,
+    // Exiting rows fly out to the winner until the model removes them.
 
     Repeater {
         id: trickRepeater
-        model: trickModel
+        model: gameBridge.trickModel
 
         delegate: Item {
             id: del
 
+            property bool entering: model.animationPhase === TrickModel.Entering
+            property bool exiting: model.animationPhase === TrickModel.Exiting
+
             // Fly-in offset: starts at (startPos - targetPos), animates to 0.
             // The x/y bindings below always point at the final target, so after
             // the offset reaches 0, the card tracks resize changes natively.
-            property real flyInOffsetX: model.noAnim ? 0
-                : (trickArea.startX(model.player) - trickArea.cardX(model.player))
-            property real flyInOffsetY: model.noAnim ? 0
-                : (trickArea.startY(model.player) - trickArea.cardY(model.player))
-            property bool flipDone: model.noAnim
+            property real flyInOffsetX: entering
+                ? (trickArea.startX(model.player) - trickArea.cardX(model.player)) : 0
+            property real flyInOffsetY: entering
+                ? (trickArea.startY(model.player) - trickArea.cardY(model.player)) : 0
+            property bool flipDone: !entering
+
+            // Exit offset toward the winner, animated from 0 once collected
+            property real exitOffsetX: exiting
+                ? (trickArea.exitX(model.winner) - trickArea.cardX(model.player)) : 0
+            property real exitOffsetY: exiting
+                ? (trickArea.exitY(model.winner) - trickArea.cardY(model.player)) : 0
 
             // Position — inlined to guarantee dependency tracking on
             // trickArea.width, trickArea.cardWidth, trickArea.cardHeight
@@ -104,25 +109,35 @@ Item {
             width: trickArea.cardWidth + 4
             height: trickArea.cardHeight + 4
             z: model.index
-            rotation: model.rot
+            rotation: model.cardRotation
+            opacity: exiting ? 0 : 1
 
-            // Visual offset for fly-in (does not break x/y bindings)
+            // Visual offset for fly-in and exit (does not break x/y bindings)
             transform: Translate {
-                x: del.flyInOffsetX
-                y: del.flyInOffsetY
+                x: del.flyInOffsetX + del.exitOffsetX
+                y: del.flyInOffsetY + del.exitOffsetY
             }
 
             Behavior on flyInOffsetX {
-                NumberAnimation { duration: 180; easing.type: Easing.OutQuad }
+                NumberAnimation { duration: 180 * gameBridge.animationScale; easing.type: Easing.OutQuad }
             }
             Behavior on flyInOffsetY {
-                NumberAnimation { duration: 180; easing.type: Easing.OutQuad }
+                NumberAnimation { duration: 180 * gameBridge.animationScale; easing.type: Easing.OutQuad }
+            }
+            Behavior on exitOffsetX {
+                NumberAnimation { duration: 200 * gameBridge.animationScale; easing.type: Easing.InQuad }
+            }
+            Behavior on exitOffsetY {
+                NumberAnimation { duration: 200 * gameBridge.animationScale; easing.type: Easing.InQuad }
+            }
+            Behavior on opacity {
+                NumberAnimation { duration: 200 * gameBridge.animationScale }
             }
 
             CardItem {
                 suit: model.suit
                 rank: model.rank
-                elementId: model.elId
+                elementId: model.elementId
                 faceUp: model.player === 0 || del.flipDone
                 playable: false
                 inTrick: true
@@ -132,7 +147,7 @@ Item {
             }
 
             Component.onCompleted: {
-                if (!model.noAnim) {
+                if (entering) {
                     // Kick off fly-in: animate offset from (start-target) to 0
                     flyInOffsetX = 0
                     flyInOffsetY = 0
@@ -142,186 +157,9 @@ Item {
             // Flip AI cards face-up partway through fly-in
             Timer {
                 running: model.player !== 0 && !del.flipDone
-                interval: 60
+                interval: 60 * gameBridge.animationScale
                 onTriggered: del.flipDone = true
             }
         }
     }
-
-    function addCard(player, suit, rank, elementId) {
-        trickModel.append({
-            "player": player,
-            "suit": suit,
-            "rank": rank,
-            "elId": elementId,
-            "rot": gameBridge.animateCardRotation ? (Math.floor(Math.random() * 11) - 5) : 0,
-            "noAnim": false
-        })
-    }
-
-    function clearTrickCards() {
-        trickModel.clear()
-        expectedCardCount = 0
-    }
-
-    function destroyExitingCards() {
-        for (var i = 0; i < exitingCards.length; i++) {
-            if (exitingCards[i]) {
-                exitingCards[i].destroy()
-            }
-        }
-        exitingCards = []
-    }
-
-    Connections {
-        target: gameBridge
-        function onCardPlayedToTrick(player, suit, rank, fromX, fromY) {
-            trickArea.expectedCardCount++
-            var tricks = gameBridge.trickCards
-            if (tricks.length > 0) {
-                var lastCard = tricks[tricks.length - 1]
-                trickArea.addCard(player, suit, rank, lastCard.elementId)
-            }
-        }
-    }
-
-    Connections {
-        target: gameBridge
-        function onTrickWonByPlayer(winner, points) {
-            // Snapshot current cards as standalone items for exit animation
-            var newExiting = []
-            for (var i = 0; i < trickModel.count; i++) {
-                var m = trickModel.get(i)
-                var item = trickRepeater.itemAt(i)
-                var posX = cardX(m.player)
-                var posY = cardY(m.player)
-                if (item) {
-                    var pos = item.mapToItem(trickArea, 0, 0)
-                    posX = pos.x
-                    posY = pos.y
-                }
-
-                var component = Qt.createComponent("CardItem.qml")
-                if (component.status === Component.Ready) {
-                    var card = component.createObject(trickArea, {
-                        "suit": m.suit,
-                        "rank": m.rank,
-                        "elementId": m.elId,
-                        "faceUp": true,
-                        "playable": false,
-                        "inTrick": true,
-                        "cardWidth": trickArea.cardWidth,
-                        "cardHeight": trickArea.cardHeight,
-                        "enableBehaviors": false,
-                        "x": posX,
-                        "y": posY,
-                        "z": 10 + i,
-                        "rotation": m.rot
-                    })
-                    newExiting.push(card)
-                }
-            }
-
-            // Clear model — Repeater delegates vanish instantly
-            trickModel.clear()
-            trickArea.expectedCardCount = 0
-
-            // Animate exit cards toward winner
-            trickArea.exitingCards = trickArea.exitingCards.concat(newExiting)
-            var ex = trickArea.exitX(winner)
-            var ey = trickArea.exitY(winner)
-
-            for (var j = 0; j < newExiting.length; j++) {
-                if (newExiting[j]) {
-                    exitAnim.createObject(newExiting[j], {
-                        "exitX": ex,
-                        "exitY": ey
-                    })
-                }
-            }
-
-            exitCleanupTimer.start()
-        }
-    }
-
-    Timer {
-        id: exitCleanupTimer
-        interval: 250
-        onTriggered: trickArea.destroyExitingCards()
-    }
-
-    Component {
-        id: exitAnim
-        Item {
-            id: exitController
-            property real exitX
-            property real exitY
-
-            ParallelAnimation {
-                running: true
-                NumberAnimation {
-                    target: exitController.parent
-                    property: "x"
-                    to: exitController.exitX
-                    duration: 200
-                    easing.type: Easing.InQuad
-                }
-                NumberAnimation {
-                    target: exitController.parent
-                    property: "y"
-                    to: exitController.exitY
-                    duration: 200
-                    easing.type: Easing.InQuad
-                }
-                NumberAnimation {
-                    target: exitController.parent
-                    property: "opacity"
-                    to: 0
-                    duration: 200
-                }
-            }
-
-            Timer {
-                running: true
-                interval: 220
-                onTriggered: exitController.destroy()
-            }
-        }
-    }
-
-    Connections {
-        target: gameBridge
-        function onTrickCardsChanged() {
-            var modelCards = gameBridge.trickCards
-
-            if (modelCards.length === 0 && trickModel.count > 0) {
-                clearTrickCards()
-                return
-            }
-
-            if (modelCards.length > 0 && modelCards.length < trickModel.count) {
-                clearTrickCards()
-            }
-
-            if (modelCards.length <= expectedCardCount) {
-                return
-            }
-
-            // Rebuild from model (game reload / undo)
-            if (trickModel.count === 0 && expectedCardCount === 0 && modelCards.length > 0) {
-                expectedCardCount = modelCards.length
-                for (var i = 0; i < modelCards.length; i++) {
-                    var c = modelCards[i]
-                    trickModel.append({
-                        "player": c.player,
-                        "suit": c.suit,
-                        "rank": c.rank,
-                        "elId": c.elementId,
-                        "rot": gameBridge.animateCardRotation ? (Math.floor(Math.random() * 11) - 5) : 0,
-                        "noAnim": true
-                    })
-                }
-            }
-        }
-    }
 }
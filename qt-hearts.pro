@@ -1,6 +1,10 @@
-QT += core gui widgets svgwidgets multimedia quick quickcontrols2 quickwidgets
+QT += core gui widgets svgwidgets multimedia qml quick quickcontrols2 quickwidgets
 
-CONFIG += c++17
+CONFIG += c++17 qmltypes qtquickcompiler
+
+# QML_ELEMENT types in the sources register as the Hearts module
+QML_IMPORT_NAME = Hearts
+QML_IMPORT_MAJOR_VERSION = 1
 
 TARGET = qt-hearts
 TEMPLATE = app
@@ -10,20 +14,48 @@ INCLUDEPATH += include
 SOURCES += \
     src/main.cpp \
     src/card.cpp \
-    src/deck.cpp \
+    src/gamestate.cpp \
+    src/checkpoint.cpp \
+    src/settingsstore.cpp \
+    src/statslog.cpp \
+    src/gamerecord.cpp \
+    src/replaysession.cpp \
     src/player.cpp \
+    src/aidecision.cpp \
+    src/gameclock.cpp \
     src/game.cpp \
     src/cardtheme.cpp \
+    src/cardatlas.cpp \
+    src/cardquickitem.cpp \
+    src/handmodel.cpp \
+    src/trickmodel.cpp \
+    src/notifybatcher.cpp \
+    src/perfmonitor.cpp \
     src/gamebridge.cpp \
     src/cardimageprovider.cpp \
     src/soundengine.cpp
 
 HEADERS += \
     include/card.h \
-    include/deck.h \
+    include/cardset.h \
+    include/rng.h \
+    include/gamestate.h \
+    include/checkpoint.h \
+    include/settingsstore.h \
+    include/statslog.h \
+    include/gamerecord.h \
+    include/replaysession.h \
     include/player.h \
+    include/aidecision.h \
+    include/gameclock.h \
     include/game.h \
     include/cardtheme.h \
+    include/cardatlas.h \
+    include/cardquickitem.h \
+    include/handmodel.h \
+    include/trickmodel.h \
+    include/notifybatcher.h \
+    include/perfmonitor.h \
     include/gamebridge.h \
     include/cardimageprovider.h \
     include/soundengine.h
@@ -0,0 +1,52 @@
+#include "aidecision.h"
+#include "rng.h"
+
+static const std::uint64_t MATCH_ID_STREAM = 0;
+static const std::uint64_t PASS_DECISION_STREAM = 64;
+
+std::uint32_t matchIdForSeed(std::uint64_t seed) {
+    return static_cast<std::uint32_t>(deriveSeed(seed, MATCH_ID_STREAM));
+}
+
+std::uint64_t dealIdForRound(std::uint64_t seed, int round) {
+    return deriveSeed(seed, static_cast<std::uint64_t>(round));
+}
+
+static void prepare(Player& ai, const GameState& state, const GameRules& rules, int roundNumber, int seat) {
+    GameContext ctx;
+    ctx.endScore = rules.endScore;
+    ctx.moonProtection = rules.moonProtection;
+    ctx.exactResetTo50 = rules.exactResetTo50;
+    ctx.roundNumber = roundNumber;
+    ctx.cardsRemaining = cardCount(state.hands[seat]);
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        ctx.playerScores[i] = state.totalScores[i];
+        ctx.roundScores[i] = state.roundScores[i];
+    }
+    ai.setHand(fromCardSet(state.hands[seat]));
+    ai.setGameContext(ctx);
+}
+
+CardSet aiPassDecision(Player& ai, const GameState& state, const GameRules& rules,
+                       int roundNumber, std::uint64_t dealId, int seat) {
+    prepare(ai, state, rules, roundNumber, seat);
+    ai.seedDecision(deriveSeed(dealId, PASS_DECISION_STREAM + seat));
+    return toCardSet(ai.selectPassCards());
+}
+
+int aiPlayDecision(Player& ai, const GameState& state, const GameRules& rules,
+                   int roundNumber, std::uint64_t dealId, int ply) {
+    int seat = state.currentPlayer();
+    prepare(ai, state, rules, roundNumber, seat);
+
+    Cards trickCards;
+    QVector<int> trickPlayers;
+    for (int i = 0; i < state.trickSize; ++i) {
+        trickCards.append(Card::fromIndex(state.trick[i]));
+        trickPlayers.append(state.trickPlayer(i));
+    }
+    Suit leadSuit = state.trickSize == 0 ? Suit::Clubs : static_cast<Suit>(state.leadSuit);
+
+    ai.seedDecision(deriveSeed(dealId, static_cast<std::uint64_t>(ply)));
+    return ai.selectPlay(leadSuit, state.isFirstTrick(), state.heartsBroken, trickCards, trickPlayers).index();
+}
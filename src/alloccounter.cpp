@@ -0,0 +1,62 @@
+#include "alloccounter.h"
+
+// Counting build of heapAllocationCount(). Replaces the global operator
+// new/delete for the whole program, so only the alloccounter object library
+// compiles it; hearts-core carries the no-op in nullalloccounter.cpp.
+
+#ifdef NDEBUG
+
+std::uint64_t heapAllocationCount() {
+    return 0;
+}
+
+#else
+
+#include <cstdlib>
+#include <new>
+
+static thread_local std::uint64_t t_allocations = 0;
+
+std::uint64_t heapAllocationCount() {
+    return t_allocations;
+}
+
+static void* countedAlloc(std::size_t size) {
+    t_allocations++;
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    t_allocations++;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    size = (size + alignment - 1) / alignment * alignment;  // aligned_alloc wants a multiple
+    if (size == 0) size = alignment;
+    for (;;) {
+        if (void* p = std::aligned_alloc(alignment, size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
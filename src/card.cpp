@@ -73,6 +73,10 @@ Card Card::fromElementId(const QString& id) {
     return Card(suit, rank);
 }
 
+Card Card::fromIndex(int index) {
+    return Card(static_cast<Suit>(cardSuit(index)), static_cast<Rank>(cardRankIndex(index) + 2));
+}
+
 QString Card::rankString() const {
     switch (m_rank) {
         case Rank::Ace:   return "A";
@@ -219,3 +223,29 @@ int countSuit(const Cards& cards, Suit suit) {
     }
     return count;
 }
+
+CardSet toCardSet(const Cards& cards) {
+    CardSet set = 0;
+    for (const Card& c : cards) {
+        set |= cardBit(c.index());
+    }
+    return set;
+}
+
+Cards fromCardSet(CardSet set) {
+    Cards result;
+    result.reserve(cardCount(set));
+    while (set) {
+        result.append(Card::fromIndex(popFirstCard(set)));
+    }
+    return result;
+}
+
+const QString& cardElementId(int index) {
+    static const QVector<QString> ids = [] {
+        QVector<QString> v;
+        for (int i = 0; i < CARD_COUNT; ++i) v.append(Card::fromIndex(i).elementId());
+        return v;
+    }();
+    return ids[index];
+}
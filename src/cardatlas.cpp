@@ -0,0 +1,324 @@
+#include "cardatlas.h"
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QSGTexture>
+#include <QThreadPool>
+#include <QtMath>
+
+CardAtlas::CardAtlas(CardTheme* theme, QObject* parent)
+    : QObject(parent)
+    , m_theme(theme)
+{
+}
+
+void CardAtlas::setTheme(CardTheme* theme) {
+    m_theme = theme;
+    invalidate();
+}
+
+quint64 CardAtlas::keyOf(const QSize& size, qreal dpr) {
+    if (size.isEmpty()) return 0;
+    return (quint64(qCeil(size.width() * dpr)) << 32) | quint64(qCeil(size.height() * dpr));
+}
+
+QSize CardAtlas::cellSize(quint64 key) {
+    return QSize(int(key >> 32), int(key & 0xffffffff));
+}
+
+QRect CardAtlas::slotRect(quint64 key, int slot) {
+    QSize cell = cellSize(key);
+    int col = slot % COLUMNS;
+    int row = slot / COLUMNS;
+    return QRect(PADDING + col * (cell.width() + PADDING), PADDING + row * (cell.height() + PADDING),
+                 cell.width(), cell.height());
+}
+
+quint64 CardAtlas::acquire(const QSize& size, qreal dpr) {
+    quint64 key = keyOf(size, dpr);
+    if (!key || !m_theme) return 0;
+
+    auto it = m_atlases.find(key);
+    if (it == m_atlases.end()) {
+        it = m_atlases.insert(key, Atlas());
+        it->size = size;
+        it->dpr = dpr;
+        build(key, *it);
+    }
+    it->refs++;
+    it->lastUse = ++m_useCounter;
+    return key;
+}
+
+bool CardAtlas::isReady(quint64 key) const {
+    auto it = m_atlases.constFind(key);
+    return it != m_atlases.constEnd() && !it->image.isNull();
+}
+
+// Every card is queued on its own so the workers share them; the packing job
+// queued behind them mostly finds them cached. Jobs check the token and skip
+// their work once the build is cancelled.
+void CardAtlas::build(quint64 key, Atlas& atlas) {
+    cancelBuild(atlas);
+    CancelToken token = std::make_shared<std::atomic<bool>>(false);
+    atlas.build = token;
+
+    CardTheme* theme = m_theme;
+    PerfMonitor* monitor = m_monitor;
+    QSize size = atlas.size;
+    qreal dpr = atlas.dpr;
+
+    QThreadPool* pool = theme->renderPool();
+    for (int slot = 0; slot < SLOTS; ++slot) {
+        pool->start([theme, token, slot, size, dpr]() {
+            if (!*token) theme->cardImage(slot, size, dpr);
+        });
+    }
+    pool->start([this, theme, monitor, token, key, size, dpr]() {
+        if (*token) return;
+        QElapsedTimer timer;
+        timer.start();
+        QSize cell = cellSize(key);
+        int rows = (SLOTS + COLUMNS - 1) / COLUMNS;
+        QImage image(PADDING + COLUMNS * (cell.width() + PADDING), PADDING + rows * (cell.height() + PADDING),
+                     QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        for (int slot = 0; slot < SLOTS; ++slot) {
+            if (*token) return;
+            painter.drawImage(slotRect(key, slot), theme->cardImage(slot, size, dpr));
+        }
+        painter.end();
+        if (monitor) monitor->record(PerfMonitor::AtlasBuild, timer.nsecsElapsed());
+
+        // The theme, and with it this pool, is destroyed before the atlas
+        QMetaObject::invokeMethod(this, [this, key, token, image]() {
+            finishBuild(key, token, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void CardAtlas::cancelBuild(Atlas& atlas) {
+    if (atlas.build) *atlas.build = true;
+    atlas.build.reset();
+}
+
+void CardAtlas::finishBuild(quint64 key, const CancelToken& token, const QImage& image) {
+    auto it = m_atlases.find(key);
+    if (it == m_atlases.end() || it->build != token) return;
+    it->build.reset();
+    retire(*it);
+    it->image = image;
+    emit built(key);
+}
+
+void CardAtlas::release(quint64 key) {
+    auto it = m_atlases.find(key);
+    if (it == m_atlases.end()) return;
+    if (--it->refs == 0 && it->build) {
+        // Nobody waits for this build any more; don't let it hold up the next
+        cancelBuild(*it);
+        retire(*it);
+        m_atlases.erase(it);
+        return;
+    }
+    trim();
+}
+
+// Drops unreferenced atlases beyond MAX_SIZES, least recently used first
+void CardAtlas::trim() {
+    while (m_atlases.size() > MAX_SIZES) {
+        auto oldest = m_atlases.end();
+        for (auto a = m_atlases.begin(); a != m_atlases.end(); ++a) {
+            if (a->refs == 0 && (oldest == m_atlases.end() || a->lastUse < oldest->lastUse)) oldest = a;
+        }
+        if (oldest == m_atlases.end()) return;
+        cancelBuild(*oldest);
+        retire(*oldest);
+        m_atlases.erase(oldest);
+    }
+}
+
+QSGTexture* CardAtlas::texture(QQuickWindow* window, quint64 key) {
+    auto it = m_atlases.find(key);
+    if (it == m_atlases.end() || it->image.isNull()) return nullptr;
+
+    QSGTexture*& texture = it->textures[window];
+    if (!texture) {
+        watchWindow(window);
+        texture = window->createTextureFromImage(it->image);
+        texture->setFiltering(QSGTexture::Linear);
+    }
+    return texture;
+}
+
+void CardAtlas::invalidate() {
+    for (auto it = m_atlases.begin(); it != m_atlases.end();) {
+        if (it->refs == 0) {
+            cancelBuild(*it);
+            retire(*it);
+            it = m_atlases.erase(it);
+        } else {
+            build(it.key(), *it);
+            ++it;
+        }
+    }
+}
+
+void CardAtlas::retire(Atlas& atlas) {
+    for (QSGTexture* texture : atlas.textures) m_retired.append(texture);
+    atlas.textures.clear();
+}
+
+void CardAtlas::watchWindow(QQuickWindow* window) {
+    if (m_windows.contains(window)) return;
+    m_windows.append(window);
+
+    // Every item has switched texture by the end of a sync; free the old ones
+    connect(window, &QQuickWindow::afterSynchronizing, this, [this]() {
+        qDeleteAll(m_retired);
+        m_retired.clear();
+    }, Qt::DirectConnection);
+
+    // The graphics context is going away: forget textures made in it
+    connect(window, &QQuickWindow::sceneGraphInvalidated, this, [this, window]() {
+        for (Atlas& atlas : m_atlases) {
+            if (QSGTexture* texture = atlas.textures.take(window)) delete texture;
+        }
+    }, Qt::DirectConnection);
+    connect(window, &QObject::destroyed, this, [this, window]() { m_windows.removeOne(window); });
+}
+
+// ============================================================================
+// CardImage
+// ============================================================================
+
+CardImage::CardImage(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+CardImage::~CardImage() {
+    if (m_atlas) {
+        m_atlas->release(m_key);
+        m_atlas->release(m_pendingKey);
+    }
+}
+
+void CardImage::setAtlas(CardAtlas* atlas) {
+    if (m_atlas == atlas) return;
+    if (m_atlas) {
+        disconnect(m_atlas, nullptr, this, nullptr);
+        m_atlas->release(m_key);
+        m_atlas->release(m_pendingKey);
+        m_key = 0;
+        m_pendingKey = 0;
+    }
+    m_atlas = atlas;
+    if (m_atlas) {
+        connect(m_atlas, &CardAtlas::built, this, [this](quint64 key) {
+            if (key == m_pendingKey) {
+                m_atlas->release(m_key);
+                m_key = key;
+                m_pendingKey = 0;
+            }
+            if (key == m_key) update();
+        });
+        connect(m_atlas, &QObject::destroyed, this, [this]() {
+            m_atlas = nullptr;
+            m_key = 0;
+            m_pendingKey = 0;
+        });
+    }
+    refresh();
+    emit atlasChanged();
+}
+
+void CardImage::setSuit(int suit) {
+    if (m_suit == suit) return;
+    m_suit = suit;
+    update();
+    emit cardChanged();
+}
+
+void CardImage::setRank(int rank) {
+    if (m_rank == rank) return;
+    m_rank = rank;
+    update();
+    emit cardChanged();
+}
+
+void CardImage::setFaceUp(bool faceUp) {
+    if (m_faceUp == faceUp) return;
+    m_faceUp = faceUp;
+    update();
+    emit cardChanged();
+}
+
+int CardImage::slot() const {
+    if (!m_faceUp) return CardAtlas::BACK;
+    int index = m_suit * SUIT_SIZE + m_rank - 2;
+    return index >= 0 && index < CARD_COUNT ? index : CardAtlas::BACK;
+}
+
+void CardImage::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) {
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) refresh();
+}
+
+void CardImage::itemChange(ItemChange change, const ItemChangeData& data) {
+    QQuickItem::itemChange(change, data);
+    if (change == ItemSceneChange || change == ItemDevicePixelRatioHasChanged) refresh();
+}
+
+void CardImage::refresh() {
+    polish();
+    update();
+}
+
+// Switches to the atlas for the current size once it is built; until then
+// the previous size is stretched to fit
+void CardImage::updatePolish() {
+    if (!m_atlas || !window()) return;
+    QSize size(qRound(width()), qRound(height()));
+    quint64 key = m_atlas->acquire(size, window()->effectiveDevicePixelRatio());
+    m_atlas->release(m_pendingKey);
+    m_pendingKey = 0;
+    if (!key || m_atlas->isReady(key)) {
+        m_atlas->release(m_key);
+        m_key = key;
+    } else {
+        m_pendingKey = key;
+    }
+}
+
+QSGTexture* CardImage::atlasTexture() const {
+    return m_atlas && m_key ? m_atlas->texture(window(), m_key) : nullptr;
+}
+
+QRect CardImage::atlasRect() const {
+    return CardAtlas::slotRect(m_key, slot());
+}
+
+QSGNode* CardImage::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) {
+    auto* node = static_cast<QSGImageNode*>(oldNode);
+    QSGTexture* texture = atlasTexture();
+    if (!texture) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = window()->createImageNode();
+        node->setOwnsTexture(false);
+        node->setFiltering(QSGTexture::Linear);
+    }
+    node->setTexture(texture);
+    node->setSourceRect(atlasRect());
+    node->setRect(boundingRect());
+    return node;
+}
@@ -0,0 +1,56 @@
+#include "cardcodes.h"
+
+static const char RANK_CODES[] = "23456789TJQKA";
+static const char SUIT_CODES[] = "CDSH";  // CardSet suit order
+
+std::string cardCode(int card) {
+    std::string code(2, '?');
+    code[0] = RANK_CODES[cardRankIndex(card)];
+    code[1] = SUIT_CODES[cardSuit(card)];
+    return code;
+}
+
+int parseCardCode(const std::string& code) {
+    if (code.size() != 2) return -1;
+    int rank = -1;
+    int suit = -1;
+    for (int i = 0; i < SUIT_SIZE; ++i) {
+        if (RANK_CODES[i] == code[0]) rank = i;
+    }
+    for (int i = 0; i < 4; ++i) {
+        if (SUIT_CODES[i] == code[1]) suit = i;
+    }
+    if (rank < 0 || suit < 0) return -1;
+    return suit * SUIT_SIZE + rank;
+}
+
+std::string cardCodes(CardSet cards, char separator) {
+    std::string out;
+    while (cards) {
+        if (!out.empty()) out += separator;
+        out += cardCode(popFirstCard(cards));
+    }
+    return out;
+}
+
+char passDirectionCode(PassDirection dir) {
+    switch (dir) {
+        case PassDirection::Left:   return 'L';
+        case PassDirection::Right:  return 'R';
+        case PassDirection::Across: return 'A';
+        case PassDirection::None:   return 'N';
+    }
+    return 'N';
+}
+
+std::vector<std::string> splitWords(const std::string& line) {
+    std::vector<std::string> words;
+    std::size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) ++i;
+        std::size_t start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') ++i;
+        if (i > start) words.push_back(line.substr(start, i - start));
+    }
+    return words;
+}
@@ -1,14 +1,31 @@
 #include "cardimageprovider.h"
 #include "card.h"
+#include <QElapsedTimer>
 #include <QGuiApplication>
 
-CardImageProvider::CardImageProvider(CardTheme* theme)
-    : QQuickImageProvider(QQuickImageProvider::Pixmap)
-    , m_theme(theme)
+// Filled from a worker; the engine reads it after finished()
+class CardImageResponse : public QQuickImageResponse {
+public:
+    void finish(const QImage& image) {
+        m_image = image;
+        emit finished();
+    }
+
+    QQuickTextureFactory* textureFactory() const override {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+private:
+    QImage m_image;
+};
+
+CardImageProvider::CardImageProvider(CardTheme* theme, PerfMonitor* monitor)
+    : m_theme(theme)
+    , m_monitor(monitor)
 {
 }
 
-QPixmap CardImageProvider::requestPixmap(const QString& id, QSize* size, const QSize& requestedSize) {
+QQuickImageResponse* CardImageProvider::requestImageResponse(const QString& id, const QSize& requestedSize) {
     // Strip query string used for cache busting
     QString cleanId = id;
     int queryIdx = id.indexOf('?');
@@ -16,25 +33,44 @@ QPixmap CardImageProvider::requestPixmap(const QString& id, QSize* size, const Q
         cleanId = id.left(queryIdx);
     }
 
+    qreal dpr = qGuiApp->devicePixelRatio();
+    auto* response = new CardImageResponse;
+    CardTheme* theme = m_theme;
+    PerfMonitor* monitor = m_monitor;
+    theme->renderPool()->start([response, theme, monitor, cleanId, requestedSize, dpr]() {
+        QElapsedTimer timer;
+        timer.start();
+        QImage image = renderImage(theme, cleanId, requestedSize, dpr);
+        if (monitor) monitor->record(PerfMonitor::ImageRequest, timer.nsecsElapsed());
+        response->finish(image);
+    });
+    return response;
+}
+
+QImage CardImageProvider::renderImage(CardTheme* theme, const QString& id, const QSize& requestedSize, qreal dpr) {
+    // Opponent fan sprite: "fan/<count>/<rotation>/<width>x<height>/<spacing>"
+    if (id.startsWith("fan/")) {
+        QStringList parts = id.split('/');
+        QStringList dims = parts.value(3).split('x');
+        if (parts.size() != 5 || dims.size() != 2) return QImage();
+        QSize cardSize(dims[0].toInt(), dims[1].toInt());
+        return theme->cardFan(parts[1].toInt(), parts[2].toInt(), cardSize, parts[4].toInt(), dpr);
+    }
+
     QSize targetSize(80, 116);
 
-    // QML sends logical pixels; CardTheme handles DPR internally
+    // QML sends logical pixels; the image carries the DPR
     if (requestedSize.isValid() && requestedSize.width() > 0 && requestedSize.height() > 0) {
         targetSize = requestedSize;
     }
 
-    // Report logical size back to QML
-    if (size) {
-        *size = targetSize;
-    }
-
-    if (cleanId == "back") {
-        return m_theme->cardBack(targetSize);
+    if (id == "back") {
+        return theme->cardBack(targetSize, dpr);
     }
 
     // Parse element ID ("1_club", "queen_spade") or integer format ("suit_rank")
-    if (cleanId.contains('_')) {
-        QStringList parts = cleanId.split('_');
+    if (id.contains('_')) {
+        QStringList parts = id.split('_');
         if (parts.size() == 2) {
             // Try integer format first
             bool suitOk, rankOk;
@@ -43,18 +79,12 @@ QPixmap CardImageProvider::requestPixmap(const QString& id, QSize* size, const Q
 
             if (suitOk && rankOk) {
                 Card card(static_cast<Suit>(suitInt), static_cast<Rank>(rankInt));
-                return m_theme->cardFront(card, targetSize);
-            }
-
-            // Fall back to element ID format
-            Card card = Card::fromElementId(cleanId);
-            if (card.isValid()) {
-                return m_theme->cardFront(card, targetSize);
+                return theme->cardFront(card, targetSize, dpr);
             }
         }
     }
 
-    // Fallback
-    Card card = Card::fromElementId(cleanId);
-    return m_theme->cardFront(card, targetSize);
+    // Element ID format
+    Card card = Card::fromElementId(id);
+    return theme->cardFront(card, targetSize, dpr);
 }
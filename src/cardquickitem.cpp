@@ -0,0 +1,168 @@
+#include "cardquickitem.h"
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QtMath>
+
+static const int CORNER_SEGMENTS = 4;
+static const QColor SHADOW_COLOR(0, 0, 0, 64);
+
+// Outline of a rounded rectangle, clockwise from the top-right corner
+static QVector<QPointF> roundedOutline(const QRectF& r, qreal radius) {
+    const QPointF centers[4] = {
+        QPointF(r.right() - radius, r.top() + radius),
+        QPointF(r.right() - radius, r.bottom() - radius),
+        QPointF(r.left() + radius, r.bottom() - radius),
+        QPointF(r.left() + radius, r.top() + radius),
+    };
+    QVector<QPointF> points;
+    points.reserve(4 * (CORNER_SEGMENTS + 1));
+    for (int corner = 0; corner < 4; ++corner) {
+        for (int i = 0; i <= CORNER_SEGMENTS; ++i) {
+            qreal angle = (corner - 1 + qreal(i) / CORNER_SEGMENTS) * M_PI / 2;
+            points.append(centers[corner] + QPointF(qCos(angle), qSin(angle)) * radius);
+        }
+    }
+    return points;
+}
+
+// Convex polygon as a zig-zag triangle strip: 0, n-1, 1, n-2, ...
+static void fillGeometry(QSGGeometry* geometry, const QRectF& rect, qreal radius) {
+    QVector<QPointF> outline = roundedOutline(rect, radius);
+    int n = outline.size();
+    geometry->allocate(n);
+    QSGGeometry::Point2D* v = geometry->vertexDataAsPoint2D();
+    for (int i = 0, lo = 0, hi = n - 1; i < n; ++i) {
+        const QPointF& p = outline[(i % 2 == 0) ? lo++ : hi--];
+        v[i].set(float(p.x()), float(p.y()));
+    }
+}
+
+// Band between two outlines, alternating outer and inner points
+static void ringGeometry(QSGGeometry* geometry, const QRectF& rect, qreal radius, qreal width) {
+    QVector<QPointF> outer = roundedOutline(rect, radius);
+    QVector<QPointF> inner = roundedOutline(rect.adjusted(width, width, -width, -width), radius - width);
+    int n = outer.size();
+    geometry->allocate(2 * (n + 1));
+    QSGGeometry::Point2D* v = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i <= n; ++i) {
+        v[2 * i].set(float(outer[i % n].x()), float(outer[i % n].y()));
+        v[2 * i + 1].set(float(inner[i % n].x()), float(inner[i % n].y()));
+    }
+}
+
+static QSGGeometryNode* colorNode() {
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    auto* node = new QSGGeometryNode();
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGFlatColorMaterial());
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+static void setNodeColor(QSGGeometryNode* node, const QColor& color) {
+    auto* material = static_cast<QSGFlatColorMaterial*>(node->material());
+    if (material->color() == color) return;
+    material->setColor(color);
+    node->markDirty(QSGNode::DirtyMaterial);
+}
+
+// Fixed layers; hidden ones are detached rather than drawn transparent
+struct CardNode : QSGNode {
+    QSGGeometryNode* shadow = colorNode();
+    QSGImageNode* image;
+    QSGGeometryNode* tint = colorNode();
+    QSGGeometryNode* border = colorNode();
+
+    explicit CardNode(QSGImageNode* imageNode) : image(imageNode) {
+        image->setOwnsTexture(false);
+        image->setFiltering(QSGTexture::Linear);
+    }
+
+    ~CardNode() override {
+        for (QSGNode* layer : {static_cast<QSGNode*>(shadow), static_cast<QSGNode*>(image),
+                               static_cast<QSGNode*>(tint), static_cast<QSGNode*>(border)}) {
+            if (!layer->parent()) delete layer;
+        }
+    }
+
+    void setLayers(bool showShadow, bool showTint, bool showBorder) {
+        if (image->parent() && (shadow->parent() != nullptr) == showShadow
+            && (tint->parent() != nullptr) == showTint && (border->parent() != nullptr) == showBorder) {
+            return;
+        }
+
+        removeAllChildNodes();
+        if (showShadow) appendChildNode(shadow);
+        appendChildNode(image);
+        if (showTint) appendChildNode(tint);
+        if (showBorder) appendChildNode(border);
+    }
+};
+
+CardQuickItem::CardQuickItem(QQuickItem* parent)
+    : CardImage(parent)
+{
+}
+
+void CardQuickItem::setBorderColor(const QColor& color) {
+    if (m_borderColor == color) return;
+    m_borderColor = color;
+    update();
+    emit borderColorChanged();
+}
+
+void CardQuickItem::setTintColor(const QColor& color) {
+    if (m_tintColor == color) return;
+    m_tintColor = color;
+    update();
+    emit tintColorChanged();
+}
+
+void CardQuickItem::setShadow(bool shadow) {
+    if (m_shadow == shadow) return;
+    m_shadow = shadow;
+    update();
+    emit shadowChanged();
+}
+
+void CardQuickItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) {
+    CardImage::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) m_geometryDirty = true;
+}
+
+QSGNode* CardQuickItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) {
+    auto* node = static_cast<CardNode*>(oldNode);
+    QSGTexture* texture = atlasTexture();
+    if (!texture) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new CardNode(window()->createImageNode());
+        m_geometryDirty = true;
+    }
+    node->image->setTexture(texture);
+    node->image->setSourceRect(atlasRect());
+
+    if (m_geometryDirty) {
+        QRectF rect = boundingRect();
+        node->image->setRect(rect);
+        fillGeometry(node->shadow->geometry(), rect.translated(0, SHADOW_OFFSET), CORNER_RADIUS);
+        fillGeometry(node->tint->geometry(), rect, CORNER_RADIUS);
+        ringGeometry(node->border->geometry(), rect.adjusted(-1, -1, 1, 1), CORNER_RADIUS, BORDER_WIDTH);
+        node->shadow->markDirty(QSGNode::DirtyGeometry);
+        node->tint->markDirty(QSGNode::DirtyGeometry);
+        node->border->markDirty(QSGNode::DirtyGeometry);
+        m_geometryDirty = false;
+    }
+
+    setNodeColor(node->shadow, SHADOW_COLOR);
+    setNodeColor(node->tint, m_tintColor);
+    setNodeColor(node->border, m_borderColor);
+    node->setLayers(m_shadow, m_tintColor.alpha() > 0, m_borderColor.alpha() > 0);
+    return node;
+}
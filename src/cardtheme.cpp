@@ -8,12 +8,20 @@
 #include <QPainterPath>
 #include <QLinearGradient>
 #include <QRadialGradient>
-#include <QApplication>
+#include <QSvgRenderer>
+#include <QThread>
+#include <memory>
+
+// Workers keep their renderers parsed between jobs, so they never expire
+static const int RENDER_THREADS_MAX = 4;
 
 CardTheme::CardTheme()
     : m_loaded(false)
     , m_usingSvg(false)
 {
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, RENDER_THREADS_MAX));
+    m_pool.setExpiryTimeout(-1);
+    m_cache.setMaxCost(DEFAULT_CACHE_BUDGET);
 }
 
 QVector<ThemeInfo> CardTheme::findThemes() {
@@ -88,7 +96,7 @@ QVector<ThemeInfo> CardTheme::findThemes() {
 }
 
 bool CardTheme::loadTheme(const QString& path) {
-    m_cache.clear();
+    setSvgPath(QString());
     m_loaded = false;
     m_usingSvg = false;
 
@@ -134,12 +142,11 @@ bool CardTheme::loadTheme(const QString& path) {
         return false;
     }
 
-    m_renderer = std::make_unique<QSvgRenderer>(svgPath);
-    if (!m_renderer->isValid()) {
-        m_renderer.reset();
+    if (!QSvgRenderer(svgPath).isValid()) {
         return false;
     }
 
+    setSvgPath(svgPath);
     m_themePath = svgPath;
     m_themeName = QFileInfo(svgPath).baseName();
     m_themeName[0] = m_themeName[0].toUpper();
@@ -150,104 +157,197 @@ bool CardTheme::loadTheme(const QString& path) {
 }
 
 void CardTheme::loadBuiltinTheme() {
-    m_cache.clear();
-    m_renderer.reset();
+    setSvgPath(QString());
     m_themeName = "Built-in";
     m_themePath.clear();
     m_loaded = true;
     m_usingSvg = false;
 }
 
-QPixmap CardTheme::renderSvgElement(const QString& elementId, const QSize& size) {
-    if (!m_renderer || !m_renderer->isValid()) {
-        return QPixmap();
-    }
+void CardTheme::setSvgPath(const QString& svgPath) {
+    QMutexLocker lock(&m_mutex);
+    m_svgPath = svgPath;
+    m_generation++;
+    m_cache.clear();
+}
 
-    qreal dpr = qApp->devicePixelRatio();
-    QString cacheKey = elementId + "_" + QString::number(size.width()) + "x" + QString::number(size.height()) + "@" + QString::number(dpr);
-    if (m_cache.contains(cacheKey)) {
-        return m_cache[cacheKey];
-    }
+void CardTheme::clearCache() {
+    QMutexLocker lock(&m_mutex);
+    m_generation++;
+    m_cache.clear();
+}
 
-    // Create HiDPI-aware pixmap
-    QPixmap pixmap(size * dpr);
-    pixmap.setDevicePixelRatio(dpr);
-    pixmap.fill(Qt::transparent);
+void CardTheme::setCacheBudget(qint64 bytes) {
+    QMutexLocker lock(&m_mutex);
+    m_cache.setMaxCost(qMax<qint64>(0, bytes));
+}
 
-    QPainter painter(&pixmap);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+qint64 CardTheme::cacheBudget() const {
+    QMutexLocker lock(&m_mutex);
+    return m_cache.maxCost();
+}
 
-    // Target rectangle fills the entire pixmap in LOGICAL coordinates
-    // The painter already has the DPR transform applied via the pixmap
-    QRectF targetRect(0, 0, size.width(), size.height());
-
-    // Try the element ID directly
-    if (m_renderer->elementExists(elementId)) {
-        m_renderer->render(&painter, elementId, targetRect);
-    } else {
-        // Try alternative formats
-        QStringList alternatives = {
-            elementId.toLower(),
-            elementId.toUpper(),
-            QString(elementId).replace("_", "-")
-        };
-
-        bool found = false;
-        for (const QString& alt : alternatives) {
-            if (m_renderer->elementExists(alt)) {
-                m_renderer->render(&painter, alt, targetRect);
-                found = true;
-                break;
-            }
-        }
+CardCacheStats CardTheme::cacheStats() const {
+    QMutexLocker lock(&m_mutex);
+    CardCacheStats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.bytes = m_cache.totalCost();
+    stats.budget = m_cache.maxCost();
+    stats.images = int(m_cache.size());
+    return stats;
+}
 
-        if (!found) {
-            painter.end();
-            return QPixmap(); // Element not found
+QImage CardTheme::cached(const CardImageKey& key, const std::function<QImage(const QString&)>& render) {
+    QMutexLocker lock(&m_mutex);
+    for (;;) {
+        // One probe; a hit also becomes the most recently used
+        if (const QImage* image = m_cache.object(key)) {
+            m_hits++;
+            return *image;
         }
+        if (!m_rendering.contains(key)) break;
+        m_rendered.wait(&m_mutex);
     }
 
-    painter.end();
-    m_cache[cacheKey] = pixmap;
-    return pixmap;
+    m_misses++;
+    m_rendering.insert(key);
+    QString svgPath = m_svgPath;
+    quint64 generation = m_generation;
+    lock.unlock();
+
+    QImage image = render(svgPath);
+
+    lock.relock();
+    m_rendering.remove(key);
+    if (generation == m_generation && !image.isNull()) {
+        m_cache.insert(key, new QImage(image), image.sizeInBytes());
+    }
+    m_rendered.wakeAll();
+    return image;
 }
 
-QPixmap CardTheme::cardFront(const Card& card, const QSize& size) {
-    if (m_usingSvg && m_renderer) {
-        QString elementId = card.elementId();
-        QPixmap pix = renderSvgElement(elementId, size);
-        if (!pix.isNull()) {
-            return pix;
+// QSvgRenderer is not thread-safe, so every thread parses its own copy
+static QSvgRenderer* threadRenderer(const QString& svgPath) {
+    thread_local QString loadedPath;
+    thread_local std::unique_ptr<QSvgRenderer> renderer;
+    if (!renderer || loadedPath != svgPath) {
+        renderer = std::make_unique<QSvgRenderer>(svgPath);
+        loadedPath = svgPath;
+    }
+    return renderer->isValid() ? renderer.get() : nullptr;
+}
+
+QImage CardTheme::renderSvgElement(const QString& svgPath, const QString& elementId, const QSize& size, qreal dpr) {
+    QSvgRenderer* renderer = threadRenderer(svgPath);
+    if (!renderer) {
+        return QImage();
+    }
+
+    // Try the element ID directly, then alternative formats
+    QString element;
+    for (const QString& candidate : {elementId, elementId.toLower(), elementId.toUpper(),
+                                     QString(elementId).replace("_", "-")}) {
+        if (renderer->elementExists(candidate)) {
+            element = candidate;
+            break;
         }
     }
+    if (element.isEmpty()) {
+        return QImage(); // Element not found
+    }
+
+    // Create HiDPI-aware image
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
 
-    return generateCard(card, size);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    // Target rectangle fills the entire image in LOGICAL coordinates
+    // The painter already has the DPR transform applied via the image
+    renderer->render(&painter, element, QRectF(0, 0, size.width(), size.height()));
+    painter.end();
+    return image;
 }
 
-QPixmap CardTheme::cardBack(const QSize& size) {
-    if (m_usingSvg && m_renderer) {
-        QPixmap pix = renderSvgElement("back", size);
-        if (!pix.isNull()) {
-            return pix;
+QImage CardTheme::cardImage(int slot, const QSize& size, qreal dpr) {
+    if (slot < 0 || slot > BACK || size.isEmpty()) return QImage();
+
+    return cached(CardImageKey{slot, size.width(), size.height(), dpr}, [&](const QString& svgPath) {
+        Card card = slot == BACK ? Card() : Card::fromIndex(slot);
+        QImage image;
+        if (!svgPath.isEmpty()) {
+            image = renderSvgElement(svgPath, slot == BACK ? QString("back") : card.elementId(), size, dpr);
         }
-    }
+        if (image.isNull()) {
+            image = slot == BACK ? generateCardBack(size, dpr) : generateCard(card, size, dpr);
+        }
+        return image;
+    });
+}
 
-    return generateCardBack(size);
+// Cards sit in a (width + 4) x (height + 4) cell, rotated about its top-left
+// corner; fans along y for the side opponents, along x for north
+static const int FAN_MARGIN = 4;
+
+QSize CardTheme::cardFanSize(int count, int rotation, const QSize& cardSize, int spacing) {
+    if (count <= 0) return QSize();
+    int length = (count - 1) * spacing + cardSize.width() + FAN_MARGIN;
+    int depth = cardSize.height() + FAN_MARGIN;
+    if (rotation == 90 || rotation == -90) return QSize(depth, length);
+    return QSize(length, depth);
 }
 
-QPixmap CardTheme::generateCard(const Card& card, const QSize& size) {
-    qreal dpr = qApp->devicePixelRatio();
-    QString cacheKey = "gen_" + card.elementId() + "_" + QString::number(size.width()) + "x" + QString::number(size.height()) + "@" + QString::number(dpr);
-    if (m_cache.contains(cacheKey)) {
-        return m_cache[cacheKey];
-    }
+QImage CardTheme::cardFan(int count, int rotation, const QSize& cardSize, int spacing, qreal dpr) {
+    QSize fanSize = cardFanSize(count, rotation, cardSize, spacing);
+    if (fanSize.isEmpty()) return QImage();
+
+    CardImageKey key{FAN, cardSize.width(), cardSize.height(), dpr, count, rotation, spacing};
+    return cached(key, [&](const QString&) {
+        QImage back = cardBack(cardSize, dpr);
+
+        QImage image(fanSize * dpr, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+        int w = cardSize.width() + FAN_MARGIN;
+        int h = cardSize.height() + FAN_MARGIN;
+        for (int i = 0; i < count; ++i) {
+            QPointF origin;
+            if (rotation == 90)
+                origin = QPointF(h, i * spacing);
+            else if (rotation == 180)
+                origin = QPointF(i * spacing + w, h);
+            else if (rotation == -90)
+                origin = QPointF(0, i * spacing + w);
+            else
+                origin = QPointF(i * spacing, 0);
+
+            painter.save();
+            painter.translate(origin);
+            painter.rotate(rotation);
+            painter.drawImage(QRectF(QPointF(FAN_MARGIN / 2, FAN_MARGIN / 2), cardSize), back);
+            painter.restore();
+        }
+
+        painter.end();
+        return image;
+    });
+}
 
-    QPixmap pixmap(size * dpr);
-    pixmap.setDevicePixelRatio(dpr);
-    pixmap.fill(Qt::transparent);
+QImage CardTheme::generateCard(const Card& card, const QSize& size, qreal dpr) {
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
 
-    QPainter painter(&pixmap);
+    QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::TextAntialiasing);
 
@@ -296,8 +396,7 @@ QPixmap CardTheme::generateCard(const Card& card, const QSize& size) {
     drawSuitSymbol(painter, card.suit(), QRectF(cx, cy, centerSize, centerSize), color);
 
     painter.end();
-    m_cache[cacheKey] = pixmap;
-    return pixmap;
+    return image;
 }
 
 void CardTheme::drawSuitSymbol(QPainter& painter, Suit suit, const QRectF& rect, const QColor& color) {
@@ -358,18 +457,12 @@ void CardTheme::drawSuitSymbol(QPainter& painter, Suit suit, const QRectF& rect,
     painter.restore();
 }
 
-QPixmap CardTheme::generateCardBack(const QSize& size) {
-    qreal dpr = qApp->devicePixelRatio();
-    QString cacheKey = "back_" + QString::number(size.width()) + "x" + QString::number(size.height()) + "@" + QString::number(dpr);
-    if (m_cache.contains(cacheKey)) {
-        return m_cache[cacheKey];
-    }
-
-    QPixmap pixmap(size * dpr);
-    pixmap.setDevicePixelRatio(dpr);
-    pixmap.fill(Qt::transparent);
+QImage CardTheme::generateCardBack(const QSize& size, qreal dpr) {
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
 
-    QPainter painter(&pixmap);
+    QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing);
 
     qreal w = size.width();
@@ -422,6 +515,5 @@ QPixmap CardTheme::generateCardBack(const QSize& size) {
     painter.drawEllipse(emblemRect);
 
     painter.end();
-    m_cache[cacheKey] = pixmap;
-    return pixmap;
+    return image;
 }
@@ -0,0 +1,135 @@
+#include "checkpoint.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+static const quint32 CHECKPOINT_MAGIC = 0x51484b50; // "QHKP"
+static const quint16 CHECKPOINT_VERSION = 3;
+
+QByteArray MatchCheckpoint::serialize() const {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out << seed << matchId;
+    out << quint8(rules.flags()) << qint16(rules.endScore);
+    out << quint16(roundNumber);
+    for (int score : totalScores) {
+        out << qint16(score);
+    }
+    out << dealId;
+    out << quint8(passed ? 1 : 0);
+    if (passed) {
+        for (CardSet set : passes) {
+            out << quint64(set);
+        }
+    }
+    out << quint8(plays.size());
+    for (quint8 card : plays) {
+        out << card;
+    }
+
+    QByteArray data;
+    QDataStream header(&data, QIODevice::WriteOnly);
+    header.setByteOrder(QDataStream::LittleEndian);
+    header << CHECKPOINT_MAGIC << CHECKPOINT_VERSION << qChecksum(payload);
+    return data + payload;
+}
+
+bool MatchCheckpoint::deserialize(const QByteArray& data, MatchCheckpoint* out) {
+    QDataStream in(data);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic;
+    quint16 version, checksum;
+    in >> magic >> version >> checksum;
+    if (in.status() != QDataStream::Ok || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) {
+        return false;
+    }
+
+    QByteArray payload = data.mid(static_cast<int>(in.device()->pos()));
+    if (qChecksum(payload) != checksum) return false;
+
+    MatchCheckpoint cp;
+    quint8 flags, passed, playCount;
+    qint16 endScore;
+    quint16 round;
+    in >> cp.seed >> cp.matchId >> flags >> endScore >> round;
+    cp.rules.endScore = endScore;
+    cp.rules.queenBreaksHearts = flags & RuleQueenBreaksHearts;
+    cp.rules.moonProtection = flags & RuleMoonProtection;
+    cp.rules.fullPolish = flags & RuleFullPolish;
+    cp.rules.exactResetTo50 = flags & RuleExactResetTo50;
+    cp.roundNumber = round;
+    for (int& score : cp.totalScores) {
+        qint16 s;
+        in >> s;
+        score = s;
+    }
+    in >> cp.dealId >> passed;
+    cp.passed = passed != 0;
+    if (cp.passed) {
+        for (CardSet& set : cp.passes) {
+            quint64 s;
+            in >> s;
+            set = s;
+        }
+    }
+    in >> playCount;
+    if (playCount > CARD_COUNT) return false;
+    cp.plays.resize(playCount);
+    for (quint8& card : cp.plays) {
+        in >> card;
+        if (card >= CARD_COUNT) return false;
+    }
+
+    if (in.status() != QDataStream::Ok) return false;
+    *out = cp;
+    return true;
+}
+
+CheckpointStore::CheckpointStore(const QString& path)
+    : m_path(path)
+{
+    m_writer.setMaxThreadCount(1);
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+}
+
+CheckpointStore::~CheckpointStore() {
+    // Let the last checkpoint land before quitting
+    m_writer.waitForDone();
+}
+
+QString CheckpointStore::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/match.checkpoint";
+}
+
+void CheckpointStore::save(const MatchCheckpoint& checkpoint) {
+    // Serialize on the caller's thread (cheap), write on the worker
+    QByteArray data = checkpoint.serialize();
+    QString path = m_path;
+    m_writer.start([path, data]() {
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(data);
+            file.commit();
+        }
+    });
+}
+
+void CheckpointStore::clear() {
+    QString path = m_path;
+    m_writer.start([path]() {
+        QFile::remove(path);
+    });
+}
+
+bool CheckpointStore::load(MatchCheckpoint* out) const {
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    return MatchCheckpoint::deserialize(file.readAll(), out);
+}
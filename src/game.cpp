@@ -1,15 +1,17 @@
 #include "game.h"
-#include <QTimer>
+#include "aidecision.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
 
-Game::Game(QObject* parent)
+Game::Game(GameClock* clock, QObject* parent)
     : QObject(parent)
-    , m_state(GameState::NotStarted)
+    , m_clock(clock)
+    , m_state(GamePhase::NotStarted)
     , m_roundNumber(0)
     , m_passDirection(PassDirection::Left)
-    , m_currentPlayer(0)
-    , m_heartsBroken(false)
-    , m_isFirstTrick(true)
-    , m_leadSuit(Suit::Clubs)
+    , m_engine(&roundEngine(m_rules.flags()))
+    , m_core(initialState(m_rules))
 {
     // Create players: human + 3 AI
     m_players[0] = std::make_unique<Player>(0, "You", true);
@@ -31,6 +33,14 @@ AIDifficulty Game::aiDifficulty() const {
     return m_players[1]->difficulty();
 }
 
+void Game::setRules(const GameRules& rules) {
+    m_rules = rules;
+    // Rule changes take effect immediately, including mid-match
+    m_core.rules = rules.flags();
+    m_core.endScore = static_cast<std::int16_t>(rules.endScore);
+    m_engine = &roundEngine(m_core.rules);
+}
+
 Player* Game::player(int index) {
     if (index >= 0 && index < NUM_PLAYERS) {
         return m_players[index].get();
@@ -45,81 +55,118 @@ const Player* Game::player(int index) const {
     return nullptr;
 }
 
-void Game::setState(GameState state) {
+Cards Game::currentTrick() const {
+    Cards trick;
+    for (int i = 0; i < m_core.trickSize; ++i) {
+        trick.append(Card::fromIndex(m_core.trick[i]));
+    }
+    return trick;
+}
+
+QVector<int> Game::trickPlayers() const {
+    QVector<int> players;
+    for (int i = 0; i < m_core.trickSize; ++i) {
+        players.append(m_core.trickPlayer(i));
+    }
+    return players;
+}
+
+void Game::setState(GamePhase state) {
     m_state = state;
-    emit stateChanged(state);
+    markDirty(Transition::Phase);
+}
+
+void Game::publishTransition() {
+    if (!m_pending.dirty) return;
+
+    Transition t = m_pending;
+    t.phase = m_state;
+    t.currentPlayer = m_core.currentPlayer();
+    m_pending = Transition();
+    emit transition(t);
+}
+
+void Game::syncPlayers() {
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        m_players[i]->setHand(fromCardSet(m_core.hands[i]));
+        m_players[i]->setRoundScore(m_core.roundScores[i]);
+        m_players[i]->setTotalScore(m_core.totalScores[i]);
+    }
 }
 
 void Game::newGame() {
-    // Increment generation to invalidate any pending timer callbacks from previous game
-    m_gameGeneration++;
+    newGame(QRandomGenerator::global()->generate64());
+}
+
+void Game::newGame(std::uint64_t seed) {
+    Step step(this);
+
+    // Drop pending steps of the previous game
+    m_clock->cancel(GameClock::MatchLane);
 
     m_roundNumber = 0;
+    m_seed = seed;
+    m_matchId = matchIdForSeed(seed);
     m_undoHistory.clear();
 
     // Clear any in-progress state from previous game
-    m_currentTrick.clear();
-    m_trickPlayers.clear();
-    m_heartsBroken = false;
-    m_isFirstTrick = true;
-
-    for (auto& p : m_players) {
-        p->resetScores();
-    }
+    m_core = initialState(m_rules);
+    syncPlayers();
+    markDirty(Transition::Hands | Transition::Trick | Transition::Scores);
 
-    emit scoresChanged();
     emit undoAvailableChanged(false);
     dealCards();
 }
 
+void Game::suspend() {
+    Step step(this);
+    // Drop pending steps; the match lives on in its checkpoint
+    m_clock->cancel(GameClock::MatchLane);
+    setState(GamePhase::NotStarted);
+}
+
 void Game::dealCards() {
-    setState(GameState::Dealing);
+    Step step(this);
+    setState(GamePhase::Dealing);
     m_roundNumber++;
 
-    // Clear any in-progress trick from previous round/game
-    m_currentTrick.clear();
-    m_trickPlayers.clear();
-
-    // Determine pass direction (Left, Right, Across, None cycle)
-    switch ((m_roundNumber - 1) % 4) {
-        case 0: m_passDirection = PassDirection::Left; break;
-        case 1: m_passDirection = PassDirection::Right; break;
-        case 2: m_passDirection = PassDirection::Across; break;
-        case 3: m_passDirection = PassDirection::None; break;
-    }
+    m_passDirection = passDirectionForRound(m_roundNumber);
 
-    // Deal cards
-    Deck deck;
-    QVector<Cards> hands = deck.dealAll(NUM_PLAYERS);
+    // Deal cards; the deal ID reproduces this deal
+    m_dealId = dealIdForRound(m_seed, m_roundNumber);
 
+    // Start a fresh move log
     for (int i = 0; i < NUM_PLAYERS; ++i) {
-        m_players[i]->setHand(hands[i]);
+        m_roundStartTotals[i] = m_core.totalScores[i];
     }
+    m_roundPassed = false;
+    m_roundPasses = {0, 0, 0, 0};
+    m_roundPlays.clear();
+
+    m_core = dealRound(m_core, dealHands(m_dealId));
+    syncPlayers();
+    markDirty(Transition::Hands | Transition::Trick | Transition::Scores);
 
     emit cardsDealt();
 
-    // Start passing (capture generation to detect if game was reset)
-    int gen = m_gameGeneration;
-    QTimer::singleShot(500, this, [this, gen]() {
-        if (gen == m_gameGeneration) startPassing();
-    });
+    // Start passing
+    m_clock->after(500, GameClock::MatchLane, this, [this]() { startPassing(); }, "startPassing");
 }
 
 void Game::startPassing() {
+    Step step(this);
+
     // Guard against stale calls after game reset
-    if (m_state != GameState::Dealing) return;
+    if (m_state != GamePhase::Dealing) return;
 
     // No passing on "None" rounds - go straight to playing
     if (m_passDirection == PassDirection::None) {
         emit passDirectionAnnounced(m_passDirection);
-        int gen = m_gameGeneration;
-        QTimer::singleShot(500, this, [this, gen]() {
-            if (gen == m_gameGeneration) startPlaying();
-        });
+        m_clock->after(500, GameClock::MatchLane, this, [this]() { startPlaying(); }, "startPlaying");
         return;
     }
 
-    setState(GameState::Passing);
+    setState(GamePhase::Passing);
     emit passDirectionAnnounced(m_passDirection);
 
     // Clear passed cards
@@ -129,23 +176,12 @@ void Game::startPassing() {
 
     // AI players select their pass cards immediately
     for (int i = 1; i < NUM_PLAYERS; ++i) {
-        // Provide game context for strategic pass decisions
-        GameContext ctx;
-        ctx.endScore = m_rules.endScore;
-        ctx.moonProtection = m_rules.moonProtection;
-        ctx.exactResetTo50 = m_rules.exactResetTo50;
-        ctx.roundNumber = m_roundNumber;
-        ctx.cardsRemaining = 13;
-        for (int j = 0; j < NUM_PLAYERS; ++j) {
-            ctx.playerScores[j] = m_players[j]->totalScore();
-            ctx.roundScores[j] = 0; // Round hasn't started yet
-        }
-        m_players[i]->setGameContext(ctx);
-        m_passedCards[i] = m_players[i]->selectPassCards();
+        CardSet pass = aiPassDecision(*m_players[i], m_core, m_rules, m_roundNumber, m_dealId, i);
+        m_passedCards[i] = fromCardSet(pass);
     }
 
     // Wait for human
-    setState(GameState::WaitingForPass);
+    setState(GamePhase::WaitingForPass);
 }
 
 Cards Game::getValidPassCards() const {
@@ -154,7 +190,8 @@ Cards Game::getValidPassCards() const {
 }
 
 void Game::humanPassCards(const Cards& cards) {
-    if (m_state != GameState::WaitingForPass) return;
+    Step step(this);
+    if (m_state != GamePhase::WaitingForPass) return;
     if (cards.size() != CARDS_TO_PASS) return;
 
     m_passedCards[0] = cards;
@@ -162,450 +199,234 @@ void Game::humanPassCards(const Cards& cards) {
 }
 
 void Game::executePassing() {
-    // Determine who passes to whom
-    auto getTarget = [this](int from) -> int {
-        switch (m_passDirection) {
-            case PassDirection::Left:   return (from + 1) % NUM_PLAYERS;
-            case PassDirection::Right:  return (from + 3) % NUM_PLAYERS;
-            case PassDirection::Across: return (from + 2) % NUM_PLAYERS;
-            case PassDirection::None:   return from; // Should never be called
-        }
-        return from;
-    };
-
-    // Collect cards to give to each player
-    QVector<Cards> receiving(NUM_PLAYERS);
+    Hands passed;
     for (int i = 0; i < NUM_PLAYERS; ++i) {
-        int target = getTarget(i);
-        receiving[target] = m_passedCards[i];
+        passed[i] = toCardSet(m_passedCards[i]);
     }
 
     // Store cards received by human player for display
-    Cards humanReceivedCards = receiving[0];
-
-    // Remove passed cards, add received cards
+    Cards humanReceivedCards;
     for (int i = 0; i < NUM_PLAYERS; ++i) {
-        m_players[i]->removeCards(m_passedCards[i]);
-        m_players[i]->addCards(receiving[i]);
+        if (passTarget(i, m_passDirection) == 0) {
+            humanReceivedCards = m_passedCards[i];
+        }
     }
 
+    m_core = applyPass(m_core, passed, m_passDirection);
+    syncPlayers();
+    markDirty(Transition::Hands);
+
+    m_roundPassed = true;
+    m_roundPasses = passed;
+
     emit passingComplete(humanReceivedCards);
 
     // Start playing (with longer delay to allow user to see received cards)
-    int gen = m_gameGeneration;
-    QTimer::singleShot(1500, this, [this, gen]() {
-        if (gen == m_gameGeneration) startPlaying();
-    });
+    m_clock->after(1500, GameClock::MatchLane, this, [this]() { startPlaying(); }, "startPlaying");
 }
 
 void Game::startPlaying() {
-    // Guard against stale calls after game reset
-    if (m_state != GameState::Passing && m_state != GameState::WaitingForPass && m_state != GameState::Dealing) return;
+    Step step(this);
 
-    setState(GameState::Playing);
+    // Guard against stale calls after game reset
+    if (m_state != GamePhase::Passing && m_state != GamePhase::WaitingForPass && m_state != GamePhase::Dealing) return;
 
-    m_heartsBroken = false;
-    m_isFirstTrick = true;
-    m_currentTrick.clear();
-    m_trickPlayers.clear();
+    setState(GamePhase::Playing);
 
     // Reset card memory for all AI players at start of round
     for (int i = 1; i < NUM_PLAYERS; ++i) {
         m_players[i]->resetCardMemory();
     }
 
-    // Find who has 2 of clubs
-    m_currentPlayer = findTwoOfClubsPlayer();
-    m_leadSuit = Suit::Clubs;
-
-    emit currentPlayerChanged(m_currentPlayer);
+    // Holder of 2 of clubs leads (determined by the core on deal/pass)
+    markDirty(Transition::Turn);
 
-    if (m_players[m_currentPlayer]->isHuman()) {
-        setState(GameState::WaitingForPlay);
+    if (m_players[m_core.currentPlayer()]->isHuman()) {
+        setState(GamePhase::WaitingForPlay);
     } else {
-        int gen = m_gameGeneration;
-        QTimer::singleShot(500, this, [this, gen]() {
-            if (gen == m_gameGeneration) aiTurn();
-        });
-    }
-}
-
-int Game::findTwoOfClubsPlayer() const {
-    Card twoClubs(Suit::Clubs, Rank::Two);
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        if (m_players[i]->hasCard(twoClubs)) {
-            return i;
-        }
+        m_clock->after(500, GameClock::MatchLane, this, [this]() { aiTurn(); }, "aiTurn");
     }
-    return 0;
 }
 
 Cards Game::getValidPlays() const {
-    if (m_currentPlayer != 0) return Cards();
-
-    const Player* human = m_players[0].get();
-
-    if (m_currentTrick.isEmpty()) {
-        // Leading
-        if (m_isFirstTrick) {
-            // Must lead 2 of clubs
-            return Cards{Card(Suit::Clubs, Rank::Two)};
-        }
-
-        // Can lead anything except hearts (unless broken or only have hearts)
-        if (!m_heartsBroken && !hasOnlyHearts(human->hand())) {
-            Cards valid;
-            for (const Card& c : human->hand()) {
-                if (!c.isHeart()) valid.append(c);
-            }
-            return valid;
-        }
-
-        return human->hand();
-    }
-
-    // Following
-    return human->getValidPlays(m_leadSuit, m_isFirstTrick, m_heartsBroken);
+    if (m_core.currentPlayer() != 0) return Cards();
+    return fromCardSet(legalMoves(m_core));
 }
 
 void Game::humanPlayCard(const Card& card) {
-    if (m_state != GameState::WaitingForPlay) return;
-    if (m_currentPlayer != 0) return;
-
-    Cards valid = getValidPlays();
-    if (!valid.contains(card)) return;
+    Step step(this);
+    if (m_state != GamePhase::WaitingForPlay) return;
+    if (m_core.currentPlayer() != 0) return;
+    if (!(legalMoves(m_core) & cardBit(card.index()))) return;
 
     // Save state before human plays
     saveSnapshot();
 
     // Immediately change state to prevent double-play
-    setState(GameState::Playing);
-
-    // Play the card
-    m_players[0]->removeCard(card);
-
-    if (m_currentTrick.isEmpty()) {
-        m_leadSuit = card.suit();
-    }
-
-    m_currentTrick.append(card);
-    m_trickPlayers.append(0);
-
-    // Update card memory for all AI players
-    for (int i = 1; i < NUM_PLAYERS; ++i) {
-        m_players[i]->cardMemory().recordCard(card, 0, m_leadSuit);
-    }
-
-    updateHeartsBroken(card);
-
-    emit cardPlayed(0, card);
+    setState(GamePhase::Playing);
 
-    nextTurn();
+    playCard(card);
 }
 
 void Game::aiTurn() {
-    if (m_currentPlayer == 0) return; // Not AI's turn
-    if (m_state != GameState::Playing) return; // Game was reset
-
-    Player* ai = m_players[m_currentPlayer].get();
-
-    // Provide game context to AI for strategic decisions
-    GameContext ctx;
-    ctx.endScore = m_rules.endScore;
-    ctx.moonProtection = m_rules.moonProtection;
-    ctx.exactResetTo50 = m_rules.exactResetTo50;
-    ctx.roundNumber = m_roundNumber;
-    ctx.cardsRemaining = ai->hand().size();
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        ctx.playerScores[i] = m_players[i]->totalScore();
-        ctx.roundScores[i] = m_players[i]->roundScore();
-    }
-    ai->setGameContext(ctx);
+    Step step(this);
+    if (m_core.currentPlayer() == 0) return; // Not AI's turn
+    if (m_state != GamePhase::Playing) return; // Game was reset
 
-    Suit leadSuit = m_currentTrick.isEmpty() ? Suit::Clubs : m_leadSuit;
-    Card card = ai->selectPlay(leadSuit, m_isFirstTrick, m_heartsBroken, m_currentTrick, m_trickPlayers);
+    Player* ai = m_players[m_core.currentPlayer()].get();
+    QElapsedTimer timer;
+    timer.start();
+    int card = aiPlayDecision(*ai, m_core, m_rules, m_roundNumber, m_dealId, m_roundPlays.size());
+    emit aiDecisionTimed(timer.nsecsElapsed());
 
-    ai->removeCard(card);
+    playCard(Card::fromIndex(card));
+}
 
-    if (m_currentTrick.isEmpty()) {
-        m_leadSuit = card.suit();
-    }
+void Game::playCard(const Card& card) {
+    int player = m_core.currentPlayer();
+    bool wasBroken = m_core.heartsBroken;
 
-    m_currentTrick.append(card);
-    m_trickPlayers.append(m_currentPlayer);
+    m_core = m_engine->applyMove(m_core, card.index());
+    m_players[player]->removeCard(card);
+    m_roundPlays.append(static_cast<quint8>(card.index()));
 
     // Update card memory for all AI players
     for (int i = 1; i < NUM_PLAYERS; ++i) {
-        m_players[i]->cardMemory().recordCard(card, m_currentPlayer, m_leadSuit);
+        m_players[i]->cardMemory().recordCard(card, player, leadSuit());
     }
 
-    updateHeartsBroken(card);
-
-    emit cardPlayed(m_currentPlayer, card);
+    markDirty(Transition::CardPlayed | Transition::Hands | Transition::Trick);
+    if (!wasBroken && m_core.heartsBroken) {
+        markDirty(Transition::HeartsBroken);
+    }
+    m_pending.player = player;
+    m_pending.card = card;
 
     nextTurn();
 }
 
 void Game::nextTurn() {
     // Check if trick is complete
-    if (m_currentTrick.size() == NUM_PLAYERS) {
+    if (m_core.trickComplete()) {
         // Longer delay so player can see the completed trick
-        int gen = m_gameGeneration;
-        QTimer::singleShot(1500, this, [this, gen]() {
-            if (gen == m_gameGeneration) completeTrick();
-        });
+        m_clock->after(1500, GameClock::MatchLane, this, [this]() { completeTrick(); }, "completeTrick");
         return;
     }
 
     // Next player
-    m_currentPlayer = (m_currentPlayer + 1) % NUM_PLAYERS;
-    emit currentPlayerChanged(m_currentPlayer);
+    markDirty(Transition::Turn);
 
-    if (m_players[m_currentPlayer]->isHuman()) {
-        setState(GameState::WaitingForPlay);
+    if (m_players[m_core.currentPlayer()]->isHuman()) {
+        setState(GamePhase::WaitingForPlay);
     } else {
-        int gen = m_gameGeneration;
-        QTimer::singleShot(500, this, [this, gen]() {
-            if (gen == m_gameGeneration) aiTurn();
-        });
+        m_clock->after(500, GameClock::MatchLane, this, [this]() { aiTurn(); }, "aiTurn");
     }
 }
 
 void Game::completeTrick() {
+    Step step(this);
+
     // Guard against stale calls after game reset
-    if (m_state != GameState::Playing) return;
-    if (m_currentTrick.size() != NUM_PLAYERS) return; // Trick not complete
+    if (m_state != GamePhase::Playing) return;
+    if (!m_core.trickComplete()) return; // Trick not complete
 
-    setState(GameState::TrickComplete);
+    setState(GamePhase::TrickComplete);
 
-    int winner = determineTrickWinner();
+    int winner = trickWinner(m_core);
+    int points = trickPoints(m_core);
 
-    // Calculate points
-    int points = 0;
-    for (const Card& c : m_currentTrick) {
-        points += c.pointValue();
-    }
+    // Award points and clear the trick; winner leads next
+    m_core = collectTrick(m_core);
+    syncPlayers();
+    markDirty(Transition::Trick | Transition::Scores);
 
-    m_players[winner]->addRoundPoints(points);
     emit trickWon(winner, points);
-    emit scoresChanged();
-
-    // Clear trick
-    m_currentTrick.clear();
-    m_trickPlayers.clear();
-    m_isFirstTrick = false;
 
     // Check if round is over
-    if (m_players[0]->hand().isEmpty()) {
-        int gen = m_gameGeneration;
-        QTimer::singleShot(500, this, [this, gen]() {
-            if (gen == m_gameGeneration) endRound();
-        });
+    if (m_core.roundComplete()) {
+        m_clock->after(500, GameClock::MatchLane, this, [this]() { endRound(); }, "endRound");
         return;
     }
 
-    // Winner leads next trick
-    m_currentPlayer = winner;
-    emit currentPlayerChanged(m_currentPlayer);
+    markDirty(Transition::Turn);
+    setState(GamePhase::Playing);
 
-    setState(GameState::Playing);
-
-    if (m_players[m_currentPlayer]->isHuman()) {
-        setState(GameState::WaitingForPlay);
+    if (m_players[m_core.currentPlayer()]->isHuman()) {
+        setState(GamePhase::WaitingForPlay);
     } else {
-        int gen = m_gameGeneration;
-        QTimer::singleShot(500, this, [this, gen]() {
-            if (gen == m_gameGeneration) aiTurn();
-        });
-    }
-}
-
-int Game::determineTrickWinner() const {
-    int winner = m_trickPlayers[0];
-    Rank highestRank = m_currentTrick[0].rank();
-
-    for (int i = 1; i < m_currentTrick.size(); ++i) {
-        const Card& c = m_currentTrick[i];
-        // Must follow lead suit to win
-        if (c.suit() == m_leadSuit && c.rank() > highestRank) {
-            highestRank = c.rank();
-            winner = m_trickPlayers[i];
-        }
-    }
-
-    return winner;
-}
-
-void Game::updateHeartsBroken(const Card& card) {
-    if (!m_heartsBroken) {
-        if (card.isHeart()) {
-            m_heartsBroken = true;
-            emit heartsBrokenSignal();
-        } else if (card.isQueenOfSpades() && m_rules.queenBreaksHearts) {
-            m_heartsBroken = true;
-            emit heartsBrokenSignal();
-        }
+        m_clock->after(500, GameClock::MatchLane, this, [this]() { aiTurn(); }, "aiTurn");
     }
 }
 
 void Game::endRound() {
-    // Guard against stale calls after game reset
-    if (m_state != GameState::TrickComplete) return;
-
-    setState(GameState::RoundComplete);
-
-    // Check for Full Polish BEFORE applying round scores
-    // Rule: 99 points at start + takes exactly 25 = reset to 98
-    if (m_rules.fullPolish) {
-        for (int i = 0; i < NUM_PLAYERS; ++i) {
-            if (m_players[i]->totalScore() == 99 && m_players[i]->roundScore() == 25) {
-                // Full Polish! Set round score to -1 so total becomes 98
-                m_players[i]->setRoundScore(-1);
-            }
-        }
-    }
+    Step step(this);
 
-    // Check for shoot the moon
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        if (m_players[i]->roundScore() == 26) {
-            emit shootTheMoonOccurred(i);
-
-            // Determine whether to take -26 or give +26 to others
-            bool takeNegative = false;
-
-            if (m_rules.moonProtection) {
-                // Choice rule: shooter can choose -26 self OR +26 others
-                // BUT only if +26 to others would cause the shooter to LOSE
-                // (i.e., game ends AND someone else has a lower score than shooter)
-
-                int shooterTotal = m_players[i]->totalScore();
-
-                // Simulate giving +26 to others
-                bool gameWouldEnd = false;
-                int lowestOtherScore = 999;
-                for (int j = 0; j < NUM_PLAYERS; ++j) {
-                    if (j != i) {
-                        int otherNewTotal = m_players[j]->totalScore() + 26;
-                        if (otherNewTotal >= m_rules.endScore) {
-                            gameWouldEnd = true;
-                        }
-                        // Track lowest score among others (after +26)
-                        if (otherNewTotal < lowestOtherScore) {
-                            lowestOtherScore = otherNewTotal;
-                        }
-                    }
-                }
-
-                // Shooter loses if game ends AND someone else has lower score
-                // (lowest score wins in Hearts)
-                if (gameWouldEnd && lowestOtherScore < shooterTotal) {
-                    takeNegative = true;
-                }
-            }
-
-            if (takeNegative) {
-                // Shooter takes -26 (their round score becomes 0 effectively)
-                m_players[i]->addRoundPoints(-26);
-                // Others keep their current round scores (no +26)
-            } else {
-                // Standard: shooter gets 0, everyone else gets 26
-                for (int j = 0; j < NUM_PLAYERS; ++j) {
-                    if (j != i) {
-                        m_players[j]->addRoundPoints(26 - m_players[j]->roundScore());
-                    }
-                }
-                m_players[i]->addRoundPoints(-26);
-            }
-            break;
-        }
-    }
+    // Guard against stale calls after game reset
+    if (m_state != GamePhase::TrickComplete) return;
 
-    // Add round scores to totals
-    for (auto& p : m_players) {
-        p->endRound();
-    }
+    setState(GamePhase::RoundComplete);
 
-    // Apply "exactly endScore = reset to 50" rule
-    if (m_rules.exactResetTo50) {
-        for (auto& p : m_players) {
-            if (p->totalScore() == m_rules.endScore) {
-                p->setTotalScore(50);
-            }
-        }
+    int shooter = -1;
+    m_core = m_engine->scoreRound(m_core, &shooter);
+    if (shooter >= 0) {
+        emit shootTheMoonOccurred(shooter);
     }
+    syncPlayers();
 
+    markDirty(Transition::Scores);
     emit roundEnded();
-    emit scoresChanged();
 
-    // Check for game over (score > endScore, not >=, because exactly 100 may reset)
-    for (const auto& p : m_players) {
-        if (p->totalScore() >= m_rules.endScore) {
-            endGame();
-            return;
-        }
+    // Check for game over (exactly endScore may already have reset to 50)
+    if (matchOver(m_core)) {
+        endGame();
+        return;
     }
 
     // Start next round
-    int gen = m_gameGeneration;
-    QTimer::singleShot(2000, this, [this, gen]() {
-        if (gen == m_gameGeneration) dealCards();
-    });
+    m_clock->after(2000, GameClock::MatchLane, this, [this]() { dealCards(); }, "dealCards");
 }
 
 void Game::endGame() {
-    setState(GameState::GameOver);
+    setState(GamePhase::GameOver);
 
     // Find winner (lowest score)
-    int winner = 0;
-    int lowestScore = m_players[0]->totalScore();
-
-    for (int i = 1; i < NUM_PLAYERS; ++i) {
-        if (m_players[i]->totalScore() < lowestScore) {
-            lowestScore = m_players[i]->totalScore();
-            winner = i;
-        }
-    }
-
-    emit gameEnded(winner);
+    emit gameEnded(matchWinner(m_core));
 }
 
 bool Game::canUndo() const {
     // Can only undo when waiting for human input and there's history
     if (m_undoHistory.isEmpty()) return false;
     // Allow undo during human's turn or after game over
-    return m_state == GameState::WaitingForPlay ||
-           m_state == GameState::WaitingForPass ||
-           m_state == GameState::GameOver;
+    return m_state == GamePhase::WaitingForPlay ||
+           m_state == GamePhase::WaitingForPass ||
+           m_state == GamePhase::GameOver;
 }
 
 void Game::undo() {
     if (!canUndo()) return;
+    Step step(this);
 
     GameSnapshot snapshot = m_undoHistory.pop();
     restoreSnapshot(snapshot);
 
-    emit undoPerformed();
     emit undoAvailableChanged(!m_undoHistory.isEmpty());
 }
 
 void Game::saveSnapshot() {
     GameSnapshot snapshot;
-    snapshot.state = m_state;
+    snapshot.phase = m_state;
     snapshot.roundNumber = m_roundNumber;
     snapshot.passDirection = m_passDirection;
-    snapshot.currentPlayer = m_currentPlayer;
-    snapshot.heartsBroken = m_heartsBroken;
-    snapshot.isFirstTrick = m_isFirstTrick;
-    snapshot.leadSuit = m_leadSuit;
-    snapshot.currentTrick = m_currentTrick;
-    snapshot.trickPlayers = m_trickPlayers;
+    snapshot.core = m_core;
 
     for (int i = 0; i < NUM_PLAYERS; ++i) {
-        snapshot.playerStates[i].hand = m_players[i]->hand();
-        snapshot.playerStates[i].roundScore = m_players[i]->roundScore();
-        snapshot.playerStates[i].totalScore = m_players[i]->totalScore();
-        snapshot.playerStates[i].cardMemory = m_players[i]->cardMemory();
+        snapshot.cardMemories[i] = m_players[i]->cardMemory();
     }
+    snapshot.dealId = m_dealId;
+    snapshot.roundStartTotals = m_roundStartTotals;
+    snapshot.roundPassed = m_roundPassed;
+    snapshot.roundPasses = m_roundPasses;
+    snapshot.roundPlays = m_roundPlays;
 
     m_undoHistory.push(snapshot);
 
@@ -618,24 +439,119 @@ void Game::saveSnapshot() {
 }
 
 void Game::restoreSnapshot(const GameSnapshot& snapshot) {
-    m_state = snapshot.state;
+    m_state = snapshot.phase;
     m_roundNumber = snapshot.roundNumber;
     m_passDirection = snapshot.passDirection;
-    m_currentPlayer = snapshot.currentPlayer;
-    m_heartsBroken = snapshot.heartsBroken;
-    m_isFirstTrick = snapshot.isFirstTrick;
-    m_leadSuit = snapshot.leadSuit;
-    m_currentTrick = snapshot.currentTrick;
-    m_trickPlayers = snapshot.trickPlayers;
+    m_core = snapshot.core;
+    setRules(m_rules);  // Keep rule changes made since the snapshot
+
+    syncPlayers();
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        m_players[i]->setCardMemory(snapshot.cardMemories[i]);
+    }
+    m_dealId = snapshot.dealId;
+    m_roundStartTotals = snapshot.roundStartTotals;
+    m_roundPassed = snapshot.roundPassed;
+    m_roundPasses = snapshot.roundPasses;
+    m_roundPlays = snapshot.roundPlays;
+
+    markDirty(Transition::Phase | Transition::Turn | Transition::Hands |
+              Transition::Trick | Transition::Scores);
+}
+
+MatchCheckpoint Game::checkpoint() const {
+    MatchCheckpoint cp;
+    cp.seed = m_seed;
+    cp.matchId = m_matchId;
+    cp.rules = m_rules;
+    cp.roundNumber = m_roundNumber;
+    cp.totalScores = m_roundStartTotals;
+    cp.dealId = m_dealId;
+    cp.passed = m_roundPassed;
+    cp.passes = m_roundPasses;
+    cp.plays = m_roundPlays;
+    return cp;
+}
+
+bool Game::resumeMatch(const MatchCheckpoint& cp) {
+    if (cp.roundNumber < 1) return false;
+
+    // Rebuild the round on a scratch state first so a bad log changes nothing
+    GameState core = initialState(cp.rules);
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        core.totalScores[i] = static_cast<std::int16_t>(cp.totalScores[i]);
+    }
+
+    core = dealRound(core, dealHands(cp.dealId));
 
+    PassDirection dir = passDirectionForRound(cp.roundNumber);
+    if (!cp.passed && dir != PassDirection::None && !cp.plays.isEmpty()) return false;
+    if (cp.passed) {
+        for (int i = 0; i < NUM_PLAYERS; ++i) {
+            if (cardCount(cp.passes[i]) != CARDS_TO_PASS || (cp.passes[i] & ~core.hands[i])) return false;
+        }
+        core = applyPass(core, cp.passes, dir);
+    }
+
+    const RoundEngine& engine = roundEngine(cp.rules.flags());
+    std::array<CardMemory, NUM_PLAYERS> memories;
+    for (quint8 c : cp.plays) {
+        if (!(legalMoves(core) & cardBit(c))) return false;
+        int player = core.currentPlayer();
+        core = engine.applyMove(core, c);
+        for (int i = 1; i < NUM_PLAYERS; ++i) {
+            memories[i].recordCard(Card::fromIndex(c), player, static_cast<Suit>(core.leadSuit));
+        }
+        if (core.trickComplete()) core = collectTrick(core);
+    }
+
+    // Commit
+    Step step(this);
+    m_clock->cancel(GameClock::MatchLane);
+    m_undoHistory.clear();
+    setRules(cp.rules);
+    m_core = core;
+    m_roundNumber = cp.roundNumber;
+    m_seed = cp.seed;
+    m_matchId = cp.matchId;
+    m_passDirection = dir;
+    m_dealId = cp.dealId;
+    m_roundStartTotals = cp.totalScores;
+    m_roundPassed = cp.passed;
+    m_roundPasses = cp.passes;
+    m_roundPlays = cp.plays;
+    syncPlayers();
     for (int i = 0; i < NUM_PLAYERS; ++i) {
-        m_players[i]->setHand(snapshot.playerStates[i].hand);
-        m_players[i]->setRoundScore(snapshot.playerStates[i].roundScore);
-        m_players[i]->setTotalScore(snapshot.playerStates[i].totalScore);
-        m_players[i]->setCardMemory(snapshot.playerStates[i].cardMemory);
+        m_players[i]->setCardMemory(memories[i]);
     }
+    markDirty(Transition::Hands | Transition::Trick | Transition::Scores);
+
+    emit undoAvailableChanged(false);
+    emit cardsDealt();
+
+    // Continue from wherever the log stopped
+    if (!cp.passed && dir != PassDirection::None) {
+        setState(GamePhase::Dealing);
+        startPassing();
+    } else if (m_core.roundComplete()) {
+        // Saved between the last trick and endRound(): end it from the event
+        // loop, as live play does, once the caller has set up for the match
+        setState(GamePhase::TrickComplete);
+        m_clock->after(0, GameClock::MatchLane, this, [this]() { endRound(); }, "endRound");
+    } else {
+        setState(GamePhase::Playing);
+        markDirty(Transition::Turn);
+        if (m_players[m_core.currentPlayer()]->isHuman()) {
+            setState(GamePhase::WaitingForPlay);
+        } else {
+            m_clock->after(500, GameClock::MatchLane, this, [this]() { aiTurn(); }, "aiTurn");
+        }
+    }
+    return true;
+}
 
-    emit stateChanged(m_state);
-    emit scoresChanged();
-    emit currentPlayerChanged(m_currentPlayer);
+RoundRecord Game::roundRecord() const {
+    std::uint8_t plays[CARD_COUNT] = {};
+    std::copy(m_roundPlays.constBegin(), m_roundPlays.constEnd(), plays);
+    return RoundRecord::make(m_matchId, m_roundNumber, m_dealId, m_rules, m_roundPasses, plays);
 }
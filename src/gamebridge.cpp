@@ -1,40 +1,71 @@
 #include "gamebridge.h"
 #include <QTimer>
 #include <QDebug>
-#include <QSettings>
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <cstring>
+
+static const int REPLAY_TRICK_DELAY = 700;  // Full trick stays on the table before it's collected
+
+static QString recordPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/games.hrec";
+}
 
 GameBridge::GameBridge(QObject* parent)
     : QObject(parent)
-    , m_game(new Game(this))
+    , m_clock(new GameClock(this))
+    , m_game(new Game(m_clock, this))
     , m_theme(new CardTheme())
     , m_previewTheme(new CardTheme())
+    , m_atlas(new CardAtlas(m_theme, this))
     , m_sound(new SoundEngine(this))
+    , m_hand(new HandModel(this))
+    , m_trick(new TrickModel(m_clock, this))
+    , m_notify(new NotifyBatcher(this))
+    , m_perf(new PerfMonitor(this))
 {
-    connect(m_game, &Game::stateChanged, this, &GameBridge::onStateChanged);
+    connect(m_notify, &NotifyBatcher::flushed, this, &GameBridge::flushNotifications);
+    connect(m_game, &Game::aiDecisionTimed, this, [this](qint64 nsecs) {
+        m_perf->record(PerfMonitor::AiDecision, nsecs);
+    });
+    m_atlas->setMonitor(m_perf);
+    m_perf->setCardTheme(m_theme);
+    connect(m_clock, &GameClock::timeScaleChanged, this, &GameBridge::timeScaleChanged);
+    connect(m_clock, &GameClock::effectiveScaleChanged, this, &GameBridge::animationScaleChanged);
+    connect(m_clock, &GameClock::pausedChanged, this, &GameBridge::pausedChanged);
+    connect(m_game, &Game::transition, this, &GameBridge::onTransition);
     connect(m_game, &Game::cardsDealt, this, &GameBridge::onCardsDealt);
     connect(m_game, &Game::passDirectionAnnounced, this, &GameBridge::onPassDirectionAnnounced);
     connect(m_game, &Game::passingComplete, this, &GameBridge::onPassingComplete);
-    connect(m_game, &Game::cardPlayed, this, &GameBridge::onCardPlayed);
     connect(m_game, &Game::trickWon, this, &GameBridge::onTrickWon);
     connect(m_game, &Game::roundEnded, this, &GameBridge::onRoundEnded);
     connect(m_game, &Game::gameEnded, this, &GameBridge::onGameEnded);
-    connect(m_game, &Game::scoresChanged, this, &GameBridge::onScoresChanged);
-    connect(m_game, &Game::currentPlayerChanged, this, &GameBridge::onCurrentPlayerChanged);
-    connect(m_game, &Game::heartsBrokenSignal, this, &GameBridge::onHeartsBroken);
     connect(m_game, &Game::shootTheMoonOccurred, this, [this](int shooter) {
         QString name = m_game->player(shooter)->name();
         showMessage(name + " shot the moon!", 2500);
-        m_shootTheMoonCount++;
-        emit statisticsChanged();
+        m_matchMoons[shooter]++;
     });
     connect(m_game, &Game::undoAvailableChanged, this, [this](bool available) {
         m_undoAvailable = available;
         emit undoAvailableChanged();
     });
 
+    // Checkpoint the match at every round start, pass exchange and trick
+    connect(m_game, &Game::cardsDealt, this, &GameBridge::saveCheckpoint);
+    connect(m_game, &Game::passingComplete, this, &GameBridge::saveCheckpoint);
+    connect(m_game, &Game::trickWon, this, &GameBridge::saveCheckpoint);
+
+    // Append every finished round to the game-record stream
+    QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    m_records.open(recordPath().toStdString());
+    connect(m_game, &Game::roundEnded, this, [this]() {
+        m_records.append(m_game->roundRecord());
+        m_records.flush();
+    });
+
     connect(m_game, &Game::cardsDealt, m_sound, &SoundEngine::playCardShuffle);
-    connect(m_game, &Game::cardPlayed, m_sound, &SoundEngine::playCardPutDown);
     connect(m_game, &Game::gameEnded, this, [this](int winner) {
         if (winner == 0) {
             m_sound->playWin();
@@ -44,6 +75,12 @@ GameBridge::GameBridge(QObject* parent)
     });
 
     loadSettings();
+
+    // Settings are written behind; the last changes land before exit
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
+        saveSettings();
+        m_settings.flush();
+    });
 }
 
 GameBridge::~GameBridge() {
@@ -53,6 +90,59 @@ GameBridge::~GameBridge() {
 }
 
 void GameBridge::newGame() {
+    leaveReplay();
+    resetTableState();
+    m_game->newGame();
+    beginMatchStats();
+    emit matchSeedChanged();
+}
+
+bool GameBridge::playSeed(const QString& seed) {
+    bool ok = false;
+    quint64 value = seed.trimmed().toULongLong(&ok, 0);
+    if (!ok) return false;
+
+    leaveReplay();
+    resetTableState();
+    m_game->newGame(value);
+    beginMatchStats();
+    emit matchSeedChanged();
+    return true;
+}
+
+void GameBridge::resumeOrNewGame() {
+    // Pick up an interrupted match (closed or crashed) where it left off
+    leaveReplay();
+    MatchCheckpoint checkpoint;
+    if (m_checkpoints.load(&checkpoint)) {
+        resetTableState();
+        if (m_game->resumeMatch(checkpoint)) {
+            beginMatchStats();
+            emit matchSeedChanged();
+            // The match keeps the rules it was started with
+            emit endScoreChanged();
+            emit exactResetTo50Changed();
+            emit queenBreaksHeartsChanged();
+            emit moonProtectionChanged();
+            emit fullPolishChanged();
+            return;
+        }
+    }
+    newGame();
+}
+
+// Per-match statistics start from the totals on the table; rounds played
+// before a resume aren't known
+void GameBridge::beginMatchStats() {
+    for (int i = 0; i < 4; ++i) {
+        m_lastTotals[i] = m_game->player(i)->totalScore();
+        m_matchMoons[i] = 0;
+    }
+    std::memset(m_roundScores, 0, sizeof(m_roundScores));
+    m_matchClock.start();
+}
+
+void GameBridge::resetTableState() {
     m_selectedCards.clear();
     m_receivedCards.clear();
     m_gameOver = false;
@@ -63,30 +153,13 @@ void GameBridge::newGame() {
 
     emit gameOverChanged();
     emit winnerChanged();
-    emit inputBlockedChanged();
-    emit selectedCountChanged();
-
-    m_game->newGame();
+    markDirty(DirtyInputBlocked | DirtySelectedCount);
 }
 
-QVariantList GameBridge::playerHand() const {
-    QVariantList result;
-    if (!m_game) return result;
-
-    const Cards& hand = m_game->player(0)->hand();
-    for (int i = 0; i < hand.size(); ++i) {
-        const Card& card = hand[i];
-        QVariantMap cardMap;
-        cardMap["suit"] = static_cast<int>(card.suit());
-        cardMap["rank"] = static_cast<int>(card.rank());
-        cardMap["elementId"] = card.elementId();
-        cardMap["playable"] = m_validPlays.contains(card);
-        cardMap["selected"] = m_selectedCards.contains(card);
-        cardMap["received"] = m_receivedCards.contains(card);
-        cardMap["index"] = i;
-        result.append(cardMap);
+void GameBridge::saveCheckpoint() {
+    if (m_game->state() != GamePhase::GameOver) {
+        m_checkpoints.save(m_game->checkpoint());
     }
-    return result;
 }
 
 QVariantList GameBridge::opponentCardCounts() const {
@@ -94,30 +167,15 @@ QVariantList GameBridge::opponentCardCounts() const {
     if (!m_game) return result;
 
     for (int p = 1; p <= 3; ++p) {
+        if (m_replayActive) {
+            result.append(cardCount(m_replayState.hands[p]));
+            continue;
+        }
         result.append(m_game->player(p)->hand().size());
     }
     return result;
 }
 
-QVariantList GameBridge::trickCards() const {
-    QVariantList result;
-    if (!m_game) return result;
-
-    const Cards& trick = m_game->currentTrick();
-    const QVector<int>& trickPlayers = m_game->trickPlayers();
-
-    for (int i = 0; i < trick.size(); ++i) {
-        const Card& card = trick[i];
-        QVariantMap cardMap;
-        cardMap["player"] = trickPlayers[i];
-        cardMap["suit"] = static_cast<int>(card.suit());
-        cardMap["rank"] = static_cast<int>(card.rank());
-        cardMap["elementId"] = card.elementId();
-        result.append(cardMap);
-    }
-    return result;
-}
-
 QVariantList GameBridge::players() const {
     QVariantList result;
     if (!m_game) return result;
@@ -126,8 +184,17 @@ QVariantList GameBridge::players() const {
         const Player* p = m_game->player(i);
         QVariantMap playerMap;
         playerMap["name"] = p->name();
-        playerMap["score"] = p->totalScore();
-        playerMap["isCurrentPlayer"] = (i == m_currentPlayer);
+        if (m_replayActive) {
+            // Totals change when the round is scored, as in live play
+            bool roundDone = m_replayPly == CARD_COUNT;
+            const GameState& s = roundDone ? m_replay.finalState(m_replayRound) : m_replayState;
+            playerMap["score"] = s.totalScores[i];
+            playerMap["isCurrentPlayer"] = !roundDone && !m_replayState.trickComplete() &&
+                                           i == m_replayState.currentPlayer();
+        } else {
+            playerMap["score"] = p->totalScore();
+            playerMap["isCurrentPlayer"] = (i == m_currentPlayer);
+        }
         result.append(playerMap);
     }
     return result;
@@ -152,12 +219,11 @@ void GameBridge::setThemePath(const QString& path) {
     } else {
         m_theme->loadTheme(path);
     }
+    m_atlas->invalidate();
     m_themeVersion++;
     emit themeVersionChanged();
     emit themePathChanged();
-    emit playerHandChanged();
-    emit trickCardsChanged();
-    emit opponentCardCountsChanged();
+    markDirty(DirtyOpponentCardCounts);
     saveSettings();
 }
 
@@ -201,6 +267,7 @@ QVariantList GameBridge::availableThemes() const {
 void GameBridge::setAnimateCardRotation(bool v) {
     if (m_animateCardRotation == v) return;
     m_animateCardRotation = v;
+    m_trick->setRotationEnabled(v);
     emit animateCardRotationChanged();
     saveSettings();
 }
@@ -219,6 +286,12 @@ void GameBridge::setAnimatePassingCards(bool v) {
     saveSettings();
 }
 
+void GameBridge::setTimeScale(qreal scale) {
+    if (qFuzzyCompare(m_clock->timeScale() + 1, scale + 1)) return;
+    m_clock->setTimeScale(scale);
+    saveSettings();
+}
+
 int GameBridge::endScore() const {
     return m_game->rules().endScore;
 }
@@ -281,42 +354,40 @@ void GameBridge::setFullPolish(bool v) {
 
 void GameBridge::cardClicked(int suit, int rank) {
     if (m_inputBlocked || !m_game) return;
+    m_perf->markInput();
 
     Card card(static_cast<Suit>(suit), static_cast<Rank>(rank));
-    GameState state = m_game->state();
+    GamePhase state = m_game->state();
 
-    if (state == GameState::WaitingForPass) {
+    if (state == GamePhase::WaitingForPass) {
         if (m_passConfirmed) return;
 
         if (m_selectedCards.contains(card)) {
             m_selectedCards.removeOne(card);
-            emit selectedCountChanged();
-            emit playerHandChanged();
+            markDirty(DirtySelectedCount | DirtyHand);
         } else if (m_selectedCards.size() < 3) {
             m_selectedCards.append(card);
-            emit selectedCountChanged();
-            emit playerHandChanged();
+            markDirty(DirtySelectedCount | DirtyHand);
 
             // Auto-confirm when 3 cards selected
             if (m_selectedCards.size() == 3) {
                 m_inputBlocked = true;
                 m_passConfirmed = true;
-                emit inputBlockedChanged();
+                markDirty(DirtyInputBlocked);
 
-                QTimer::singleShot(400, this, [this]() {
+                m_clock->after(400, GameClock::MatchLane, this, [this]() {
                     hideMessage();
                     Cards toPass = m_selectedCards;
                     m_selectedCards.clear();
-                    emit selectedCountChanged();
-                    emit playerHandChanged();
+                    markDirty(DirtySelectedCount | DirtyHand);
                     m_game->humanPassCards(toPass);
-                });
+                }, "confirmPass");
             }
         }
-    } else if (state == GameState::WaitingForPlay) {
+    } else if (state == GamePhase::WaitingForPlay) {
         if (m_validPlays.contains(card)) {
             m_inputBlocked = true;
-            emit inputBlockedChanged();
+            markDirty(DirtyInputBlocked);
             m_game->humanPlayCard(card);
         }
     }
@@ -342,28 +413,33 @@ QVariantList GameBridge::getValidPlays() const {
 }
 
 void GameBridge::undo() {
-    if (m_game && m_undoAvailable) {
+    if (m_game && m_undoAvailable && !m_replayActive) {
         m_game->undo();
-        emit playerHandChanged();
-        emit trickCardsChanged();
-        emit opponentCardCountsChanged();
-        updateValidPlays();
     }
 }
 
 void GameBridge::quit() {
-    saveSettings();
     QCoreApplication::quit();
 }
 
 void GameBridge::resetStatistics() {
-    m_gamesPlayed = 0;
-    m_gamesWon = 0;
-    m_totalScore = 0;
-    m_bestScore = 999;
-    m_shootTheMoonCount = 0;
+    m_stats.reset();
     emit statisticsChanged();
-    saveSettings();
+}
+
+double GameBridge::avgMatchMinutes() const {
+    const StatsAggregate& a = m_stats.aggregate();
+    quint32 logged = 0;
+    for (quint32 n : a.gamesByDifficulty) logged += n;
+    return logged > 0 ? a.totalDurationSecs / 60.0 / logged : 0;
+}
+
+QVariantList GameBridge::difficultyWinRates() const {
+    QVariantList result;
+    for (int i = 0; i < StatsAggregate::DIFFICULTIES; ++i) {
+        result.append(m_stats.aggregate().winRate(i));
+    }
+    return result;
 }
 
 QString GameBridge::scoresText() const {
@@ -394,84 +470,276 @@ void GameBridge::setShowMenuBar(bool v) {
     saveSettings();
 }
 
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+QStringList GameBridge::replayMatches() const {
+    QStringList result;
+    for (int i = 0; i < m_replay.matchCount(); ++i) {
+        int rounds = m_replay.matchRoundCount(i);
+        result.append(QString("Match %1 (%2 %3)").arg(i + 1).arg(rounds).arg(rounds == 1 ? "round" : "rounds"));
+    }
+    return result;
+}
+
+bool GameBridge::openReplay(const QString& path) {
+    // Newest match first; a file that fails to load leaves the table alone
+    ReplaySession session;
+    if (!session.load(path.isEmpty() ? recordPath() : path) ||
+        !session.selectMatch(session.matchCount() - 1)) {
+        showMessage("No recorded games to replay", 2000);
+        return false;
+    }
+
+    if (!m_replayActive) {
+        // Park the live match; closeReplay() resumes it from the checkpoint
+        saveCheckpoint();
+        resetTableState();
+        hideMessage();
+        m_replayActive = true;
+        m_game->suspend();
+    }
+
+    m_replay = session;
+    seekReplay(0, 0);
+    return true;
+}
+
+void GameBridge::selectReplayMatch(int match) {
+    if (!m_replayActive || match == m_replay.currentMatch()) return;
+    if (!m_replay.selectMatch(match)) {
+        showMessage("Recorded match is damaged", 2000);
+        markDirty(DirtyReplay);
+        return;
+    }
+    seekReplay(0, 0);
+}
+
+void GameBridge::replaySeek(int round, int trick) {
+    if (!m_replayActive) return;
+    seekReplay(round, trick * 4);
+}
+
+void GameBridge::replayStepForward() {
+    if (!m_replayActive) return;
+
+    if (m_replayPly == CARD_COUNT) {
+        if (m_replayRound + 1 < m_replay.roundCount()) {
+            seekReplay(m_replayRound + 1, 0);
+        }
+        return;
+    }
+
+    // A trick still waiting on the table goes to its winner first
+    finishReplayTrick();
+
+    int player = m_replayState.currentPlayer();
+    Card card = Card::fromIndex(m_replay.play(m_replayRound, m_replayPly));
+    m_replayState = applyMove(m_replayState, card.index());
+    m_replayPly++;
+
+    m_trick->play(player, card.index());
+    emitTableChanged();
+
+    if (m_replayState.trickComplete()) {
+        m_clock->after(REPLAY_TRICK_DELAY, GameClock::ReplayLane, this, [this]() { finishReplayTrick(); },
+                       "finishReplayTrick");
+    }
+}
+
+void GameBridge::replayStepBack() {
+    if (!m_replayActive) return;
+
+    if (m_replayPly > 0) {
+        seekReplay(m_replayRound, m_replayPly - 1);
+    } else if (m_replayRound > 0) {
+        seekReplay(m_replayRound - 1, CARD_COUNT);
+    }
+}
+
+void GameBridge::closeReplay() {
+    if (m_replayActive) {
+        resumeOrNewGame();
+    }
+}
+
+void GameBridge::seekReplay(int round, int ply) {
+    m_clock->cancel(GameClock::ReplayLane);
+    m_replayRound = qBound(0, round, m_replay.roundCount() - 1);
+    m_replayPly = qBound(0, ply, static_cast<int>(CARD_COUNT));
+    m_replayState = m_replay.stateAt(m_replayRound, m_replayPly);
+
+    m_passDirection = m_replay.passDirection(m_replayRound);
+    markDirty(DirtyPassDirection);
+    m_trick->clear();
+    emitTableChanged();
+}
+
+void GameBridge::finishReplayTrick() {
+    if (!m_replayState.trickComplete()) return;
+
+    m_clock->cancel(GameClock::ReplayLane);
+    int winner = trickWinner(m_replayState);
+    int points = trickPoints(m_replayState);
+    m_replayState = collectTrick(m_replayState);
+
+    m_trick->collect(winner);
+    emit trickWonByPlayer(winner, points);
+    markDirty(DirtyPlayers);
+}
+
+void GameBridge::leaveReplay() {
+    if (!m_replayActive) return;
+
+    m_replayActive = false;
+    m_clock->cancel(GameClock::ReplayLane);
+    m_replay.clear();
+    m_replayRound = 0;
+    m_replayPly = 0;
+    m_trick->clear();
+    markDirty(DirtyReplay);
+}
+
+void GameBridge::emitTableChanged() {
+    syncTrick();
+    markDirty(DirtyHand | DirtyOpponentCardCounts | DirtyPlayers | DirtyReplay);
+}
+
 void GameBridge::updateValidPlays() {
     m_validPlays.clear();
     if (!m_game) return;
 
-    GameState state = m_game->state();
-    if (state == GameState::WaitingForPass && !m_passConfirmed) {
+    GamePhase state = m_game->state();
+    if (state == GamePhase::WaitingForPass && !m_passConfirmed) {
         m_validPlays = m_game->player(0)->hand();
-    } else if (state == GameState::WaitingForPlay && m_game->currentPlayer() == 0) {
+    } else if (state == GamePhase::WaitingForPlay && m_game->currentPlayer() == 0) {
         if (!m_showingReceivedCards) {
             m_validPlays = m_game->getValidPlays();
-            m_inputBlocked = false;
-            emit inputBlockedChanged();
+            setInputBlocked(false);
         }
     } else {
-        m_inputBlocked = true;
-        emit inputBlockedChanged();
+        setInputBlocked(true);
     }
 
-    emit playerHandChanged();
+    markDirty(DirtyHand);
+}
+
+// Pushes South's hand and card flags into the hand model, which emits
+// row or role changes only for the cards that differ
+void GameBridge::syncHand() {
+    if (m_replayActive) {
+        // Show which cards were legal when it's South's turn in the replay
+        m_hand->setCards(m_replayState.hands[0]);
+        m_hand->setPlayable(m_replayState.currentPlayer() == 0 ? legalMoves(m_replayState) : 0);
+        m_hand->setSelected(0);
+        m_hand->setReceived(0);
+        return;
+    }
+
+    m_hand->setCards(toCardSet(m_game->player(0)->hand()));
+    m_hand->setPlayable(toCardSet(m_validPlays));
+    m_hand->setSelected(toCardSet(m_selectedCards));
+    m_hand->setReceived(toCardSet(m_receivedCards));
+}
+
+void GameBridge::syncTrick() {
+    m_trick->setTrick(m_replayActive ? m_replayState : m_game->core());
+}
+
+void GameBridge::flushNotifications(quint32 bits) {
+    if (bits & DirtyHand) syncHand();
+    if (bits & DirtyOpponentCardCounts) emit opponentCardCountsChanged();
+    if (bits & DirtyPlayers) emit playersChanged();
+    if (bits & DirtyGameState) emit gameStateChanged();
+    if (bits & DirtyInputBlocked) emit inputBlockedChanged();
+    if (bits & DirtySelectedCount) emit selectedCountChanged();
+    if (bits & DirtyPassDirection) emit passDirectionChanged();
+    if (bits & DirtyMessage) emit messageChanged();
+    if (bits & DirtyReplay) emit replayChanged();
+}
+
+void GameBridge::setInputBlocked(bool blocked) {
+    if (m_inputBlocked == blocked) return;
+    m_inputBlocked = blocked;
+    markDirty(DirtyInputBlocked);
 }
 
 void GameBridge::showMessage(const QString& text, int durationMs) {
     m_message = text;
-    emit messageChanged();
+    markDirty(DirtyMessage);
 
     if (durationMs > 0) {
-        if (m_messageTimer) {
-            m_messageTimer->stop();
-            m_messageTimer->deleteLater();
-        }
-        m_messageTimer = new QTimer(this);
-        m_messageTimer->setSingleShot(true);
-        connect(m_messageTimer, &QTimer::timeout, this, &GameBridge::hideMessage);
-        m_messageTimer->start(durationMs);
+        if (m_messageTimer) m_clock->cancel(m_messageTimer);
+        m_messageTimer = m_clock->after(durationMs, GameClock::TableLane, this, [this]() { hideMessage(); },
+                                        "hideMessage");
     }
 }
 
 void GameBridge::hideMessage() {
     m_message.clear();
-    emit messageChanged();
+    markDirty(DirtyMessage);
     if (m_messageTimer) {
-        m_messageTimer->deleteLater();
-        m_messageTimer = nullptr;
+        m_clock->cancel(m_messageTimer);
+        m_messageTimer = 0;
     }
 }
 
-void GameBridge::onStateChanged(GameState state) {
-    emit gameStateChanged();
+void GameBridge::onTransition(const Transition& t) {
+    // One engine step, applied as one diff: each property is re-emitted at
+    // most once and the hand list is rebuilt at most once
+    if (t.dirty & Transition::CardPlayed) {
+        // Appended before the trick sync below, so the card flies in
+        m_trick->play(t.player, t.card.index());
+        m_sound->playCardPutDown();
+    }
 
-    if (state == GameState::WaitingForPass || state == GameState::WaitingForPlay) {
-        m_inputBlocked = m_showingReceivedCards;
-    } else {
-        m_inputBlocked = true;
+    if (t.dirty & Transition::Phase) {
+        markDirty(DirtyGameState);
+        bool waiting = t.phase == GamePhase::WaitingForPass || t.phase == GamePhase::WaitingForPlay;
+        setInputBlocked(waiting ? m_showingReceivedCards : true);
+    }
+
+    if (t.dirty & Transition::Trick) {
+        syncTrick();
+    }
+    if (t.dirty & Transition::Hands) {
+        markDirty(DirtyOpponentCardCounts);
+    }
+
+    if (t.dirty & Transition::Turn) {
+        m_currentPlayer = t.currentPlayer;
+        if (t.currentPlayer == 0) {
+            showMessage("Your turn", 1000);
+        }
+    }
+    if (t.dirty & (Transition::Turn | Transition::Scores)) {
+        markDirty(DirtyPlayers);
+    }
+
+    if (t.dirty & Transition::HeartsBroken) {
+        showMessage("Hearts broken!", 1500);
+        emit heartsBrokenSignal();
     }
-    emit inputBlockedChanged();
 
-    updateValidPlays();
+    // Valid plays depend on phase, turn and hand; this also refreshes the hand
+    if (t.dirty & (Transition::Phase | Transition::Turn | Transition::Hands)) {
+        updateValidPlays();
+    }
 }
 
 void GameBridge::onCardsDealt() {
+    // Hand, trick and input state refresh with the deal's transition
     m_selectedCards.clear();
     m_receivedCards.clear();
     m_passConfirmed = false;
     m_showingReceivedCards = false;
-    m_inputBlocked = false;
-
-    emit selectedCountChanged();
-    emit inputBlockedChanged();
-    emit playerHandChanged();
-    emit opponentCardCountsChanged();
-    emit trickCardsChanged();
-
-    updateValidPlays();
+    markDirty(DirtySelectedCount);
 }
 
 void GameBridge::onPassDirectionAnnounced(PassDirection dir) {
     m_passDirection = dir;
-    emit passDirectionChanged();
+    markDirty(DirtyPassDirection);
 
     if (dir == PassDirection::None) {
         showMessage("No passing this round - Hold", 1500);
@@ -488,9 +756,10 @@ void GameBridge::onPassingComplete(Cards receivedCards) {
     m_inputBlocked = true;
     m_showingReceivedCards = true;
 
-    emit selectedCountChanged();
-    emit inputBlockedChanged();
-    emit playerHandChanged();
+    markDirty(DirtySelectedCount | DirtyInputBlocked);
+
+    // The fly-in animation looks the received cards up in the hand model
+    syncHand();
 
     QVariantList cardsList;
     for (const Card& card : receivedCards) {
@@ -504,39 +773,34 @@ void GameBridge::onPassingComplete(Cards receivedCards) {
 
     showMessage("Cards received!", 1500);
 
-    QTimer::singleShot(1500, this, [this]() {
+    m_clock->after(1500, GameClock::MatchLane, this, [this]() {
         m_receivedCards.clear();
         m_showingReceivedCards = false;
         m_inputBlocked = false;
-        emit inputBlockedChanged();
-        emit playerHandChanged();
+        markDirty(DirtyInputBlocked);
         updateValidPlays();
-    });
-}
-
-void GameBridge::onCardPlayed(int player, Card card) {
-    // Signal before model change so TrickArea's expectedCardCount prevents duplicates
-    emit cardPlayedToTrick(player, static_cast<int>(card.suit()), static_cast<int>(card.rank()), 0, 0);
-
-    emit trickCardsChanged();
-    emit playerHandChanged();
-    emit opponentCardCountsChanged();
-    updateValidPlays();
+    }, "releaseReceivedCards");
 }
 
 void GameBridge::onTrickWon(int winner, int points) {
     QString name = m_game->player(winner)->name();
     showMessage(name + " wins trick" + (points > 0 ? QString(" (+%1)").arg(points) : ""), 1500);
 
+    m_trick->collect(winner);
     emit trickWonByPlayer(winner, points);
-
-    QTimer::singleShot(800, this, [this]() {
-        emit trickCardsChanged();
-    });
 }
 
 void GameBridge::onRoundEnded() {
     showMessage("Round complete!", 2000);
+
+    int round = m_game->roundNumber() - 1;
+    for (int i = 0; i < 4; ++i) {
+        int total = m_game->player(i)->totalScore();
+        if (round >= 0 && round < MatchStatsRecord::MAX_ROUNDS) {
+            m_roundScores[round][i] = static_cast<qint8>(total - m_lastTotals[i]);
+        }
+        m_lastTotals[i] = total;
+    }
 }
 
 void GameBridge::onGameEnded(int winner) {
@@ -545,42 +809,32 @@ void GameBridge::onGameEnded(int winner) {
     emit gameOverChanged();
     emit winnerChanged();
 
-    // Update statistics
-    m_gamesPlayed++;
-    int myScore = m_game->player(0)->totalScore();
-    m_totalScore += myScore;
-    if (myScore < m_bestScore) {
-        m_bestScore = myScore;
-    }
-    if (winner == 0) {
-        m_gamesWon++;
+    // Append the match to the statistics history
+    MatchStatsRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.seed = m_game->seed();
+    record.finishedAt = QDateTime::currentMSecsSinceEpoch();
+    record.durationSecs = static_cast<quint32>(m_matchClock.isValid() ? m_matchClock.elapsed() / 1000 : 0);
+    record.matchId = m_game->matchId();
+    record.rules = m_game->rules().flags();
+    record.difficulty = static_cast<quint8>(m_game->aiDifficulty());
+    record.winner = static_cast<quint8>(winner);
+    record.roundCount = static_cast<quint8>(qMin(m_game->roundNumber(), 255));
+    record.endScore = static_cast<qint16>(m_game->rules().endScore);
+    for (int i = 0; i < 4; ++i) {
+        record.finalScores[i] = static_cast<qint16>(m_game->player(i)->totalScore());
+        record.moonShots[i] = m_matchMoons[i];
     }
+    std::memcpy(record.roundScores, m_roundScores, sizeof(record.roundScores));
+    m_stats.append(record);
     emit statisticsChanged();
-    saveSettings();
-}
 
-void GameBridge::onScoresChanged() {
-    emit playersChanged();
-}
-
-void GameBridge::onCurrentPlayerChanged(int player) {
-    m_currentPlayer = player;
-    emit playersChanged();
-
-    if (player == 0) {
-        showMessage("Your turn", 1000);
-    }
-
-    updateValidPlays();
-}
-
-void GameBridge::onHeartsBroken() {
-    showMessage("Hearts broken!", 1500);
-    emit heartsBrokenSignal();
+    // Match finished: nothing to resume
+    m_checkpoints.clear();
 }
 
 void GameBridge::loadSettings() {
-    QSettings settings("Hearts", "Hearts");
+    const SettingsStore& settings = m_settings;
 
     // Theme
     QString savedTheme = settings.value("theme", "").toString();
@@ -622,22 +876,35 @@ void GameBridge::loadSettings() {
 
     // Animation settings
     m_animateCardRotation = settings.value("animations/cardRotation", true).toBool();
+    m_trick->setRotationEnabled(m_animateCardRotation);
     m_animateAICards = settings.value("animations/aiCards", true).toBool();
     m_animatePassingCards = settings.value("animations/passingCards", true).toBool();
+    m_clock->setTimeScale(settings.value("animations/timeScale", 1.0).toDouble());
+
+    // Card image cache
+    m_theme->setCacheBudget(qint64(settings.value("cards/cacheBudgetMB", int(CardTheme::DEFAULT_CACHE_BUDGET >> 20)).toInt()) << 20);
 
     // UI
     m_showMenuBar = settings.value("ui/showMenuBar", true).toBool();
 
-    // Statistics
-    m_gamesPlayed = settings.value("stats/gamesPlayed", 0).toInt();
-    m_gamesWon = settings.value("stats/gamesWon", 0).toInt();
-    m_totalScore = settings.value("stats/totalScore", 0).toInt();
-    m_bestScore = settings.value("stats/bestScore", 999).toInt();
-    m_shootTheMoonCount = settings.value("stats/shootTheMoon", 0).toInt();
+    // Statistics used to be counters in settings; fold them into the history
+    // once. The import record in the log, not these keys, marks it done.
+    if (settings.value("stats/gamesPlayed", 0).toInt() > 0 && !m_stats.hasImported()) {
+        m_stats.importTotals(settings.value("stats/gamesPlayed", 0).toInt(),
+                             settings.value("stats/gamesWon", 0).toInt(),
+                             settings.value("stats/totalScore", 0).toInt(),
+                             settings.value("stats/bestScore", 999).toInt(),
+                             settings.value("stats/shootTheMoon", 0).toInt());
+    }
+    for (const char* key : {"stats/gamesPlayed", "stats/gamesWon", "stats/totalScore",
+                            "stats/bestScore", "stats/shootTheMoon"}) {
+        m_settings.remove(key);
+    }
 }
 
+// Cheap: the store only writes to disk once the changes settle
 void GameBridge::saveSettings() {
-    QSettings settings("Hearts", "Hearts");
+    SettingsStore& settings = m_settings;
     settings.setValue("theme", m_theme->themePath());
     settings.setValue("cardScale", m_cardScale);
     settings.setValue("soundEnabled", m_soundEnabled);
@@ -655,15 +922,10 @@ void GameBridge::saveSettings() {
     settings.setValue("animations/cardRotation", m_animateCardRotation);
     settings.setValue("animations/aiCards", m_animateAICards);
     settings.setValue("animations/passingCards", m_animatePassingCards);
+    settings.setValue("animations/timeScale", m_clock->timeScale());
+    settings.setValue("cards/cacheBudgetMB", int(m_theme->cacheBudget() >> 20));
 
     // UI
     settings.setValue("ui/showMenuBar", m_showMenuBar);
-
-    // Statistics
-    settings.setValue("stats/gamesPlayed", m_gamesPlayed);
-    settings.setValue("stats/gamesWon", m_gamesWon);
-    settings.setValue("stats/totalScore", m_totalScore);
-    settings.setValue("stats/bestScore", m_bestScore);
-    settings.setValue("stats/shootTheMoon", m_shootTheMoonCount);
 }
 
@@ -0,0 +1,141 @@
+#include "gameclock.h"
+
+static const char* const LANE_NAMES[GameClock::LaneCount] = {"match", "replay", "table"};
+
+GameClock::GameClock(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &GameClock::runDue);
+    m_wall.start();
+}
+
+void GameClock::setTimeScale(qreal scale) {
+    scale = qBound(0.0, scale, 1.0);
+    if (qFuzzyCompare(m_timeScale + 1, scale + 1)) return;
+    m_timeScale = scale;
+    emit timeScaleChanged();
+    if (!m_hidden) emit effectiveScaleChanged();
+}
+
+quint64 GameClock::after(int ms, Lane lane, QObject* context, std::function<void()> f, const char* label) {
+    quint64 id = m_nextId++;
+    m_queue.emplace(Key(now() + scaled(ms), id), Entry{id, lane, context, std::move(f), label});
+    rearm();
+    return id;
+}
+
+void GameClock::cancel(Lane lane) {
+    m_epochs[lane]++;
+    for (auto it = m_queue.begin(); it != m_queue.end();) {
+        it = it->second.lane == lane ? m_queue.erase(it) : std::next(it);
+    }
+    rearm();
+}
+
+bool GameClock::cancel(quint64 id) {
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+        if (it->second.id == id) {
+            m_queue.erase(it);
+            rearm();
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameClock::setPaused(bool paused) {
+    if (m_paused == paused) return;
+    if (paused) {
+        m_base = now();
+    } else {
+        m_wall.restart();
+    }
+    m_paused = paused;
+    rearm();
+    emit pausedChanged();
+    if (!m_paused && m_hidden) fastForward();
+}
+
+void GameClock::advance(qint64 ms) {
+    qint64 target = now() + ms;
+    int budget = FAST_FORWARD_LIMIT;
+    while (!m_queue.empty() && m_queue.begin()->first.first <= target && budget-- > 0) {
+        runFirst();
+    }
+    m_base += target - now();
+    rearm();
+}
+
+void GameClock::fastForward() {
+    int budget = FAST_FORWARD_LIMIT;
+    while (!m_queue.empty() && budget-- > 0) {
+        runFirst();
+    }
+    rearm();
+}
+
+void GameClock::setHidden(bool hidden) {
+    if (m_hidden == hidden) return;
+    m_hidden = hidden;
+    if (m_timeScale > 0) emit effectiveScaleChanged();
+    if (m_hidden && !m_paused) fastForward();
+}
+
+int GameClock::pendingCount(Lane lane) const {
+    int count = 0;
+    for (const auto& item : m_queue) {
+        if (item.second.lane == lane) count++;
+    }
+    return count;
+}
+
+QVector<GameClock::Pending> GameClock::pending() const {
+    QVector<Pending> out;
+    qint64 t = now();
+    for (const auto& item : m_queue) {
+        out.append({item.second.lane, item.second.label, qMax<qint64>(0, item.first.first - t)});
+    }
+    return out;
+}
+
+QStringList GameClock::describePending() const {
+    QStringList out;
+    for (const Pending& p : pending()) {
+        out.append(QString("%1 %2 in %3 ms").arg(LANE_NAMES[p.lane], p.label).arg(p.remaining));
+    }
+    return out;
+}
+
+// Runs what was due when the timer fired. Callbacks scheduled meanwhile wait
+// for the next pass of the event loop, even at zero delay.
+void GameClock::runDue() {
+    qint64 t = now();
+    quint64 limit = m_nextId;
+    while (!m_paused && !m_queue.empty() && m_queue.begin()->first.first <= t
+           && m_queue.begin()->second.id < limit) {
+        runFirst();
+    }
+    rearm();
+}
+
+// Pops the earliest callback and runs it, moving the clock up to its due
+// time if it was reached early
+void GameClock::runFirst() {
+    auto it = m_queue.begin();
+    qint64 due = it->first.first;
+    Entry entry = std::move(it->second);
+    m_queue.erase(it);
+
+    if (due > now()) m_base += due - now();
+    if (entry.context) entry.callback();
+}
+
+void GameClock::rearm() {
+    if (m_paused || m_queue.empty()) {
+        m_timer.stop();
+        return;
+    }
+    qint64 wait = m_queue.begin()->first.first - now();
+    m_timer.start(static_cast<int>(qMax<qint64>(0, wait)));
+}
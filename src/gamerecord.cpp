@@ -0,0 +1,307 @@
+#include "gamerecord.h"
+#include <QFile>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Records are mapped in place and stored little-endian");
+
+static const std::uint32_t FILE_MAGIC = 0x52474851;   // "QHGR"
+static const std::uint32_t BLOCK_MAGIC = 0x42474851;  // "QHGB"
+static const std::uint16_t FORMAT_VERSION = 2;  // 2: portable shuffle (deal IDs from v1 deal differently)
+static const std::uint8_t NO_CARD = 63;
+
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t recordSize;
+    std::uint32_t reserved[2];
+};
+
+struct BlockHeader {
+    std::uint32_t magic;
+    std::uint32_t count;
+    std::uint32_t crc;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16 && sizeof(BlockHeader) == 16, "Headers keep records 16-byte aligned");
+
+// ============================================================================
+// 6-bit card packing
+// ============================================================================
+
+static void packCards(const std::uint8_t* cards, int count, std::uint8_t* out) {
+    std::uint32_t acc = 0;
+    int bits = 0;
+    for (int i = 0; i < count; ++i) {
+        acc |= static_cast<std::uint32_t>(cards[i] & 0x3f) << bits;
+        bits += 6;
+        while (bits >= 8) {
+            *out++ = static_cast<std::uint8_t>(acc);
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) *out = static_cast<std::uint8_t>(acc);
+}
+
+static int unpackCard(const std::uint8_t* in, int i) {
+    int bit = i * 6;
+    int byte = bit >> 3;
+    int shift = bit & 7;
+    unsigned value = in[byte];
+    if (shift > 2) value |= static_cast<unsigned>(in[byte + 1]) << 8;  // Spans two bytes
+    return static_cast<int>((value >> shift) & 0x3f);
+}
+
+RoundRecord RoundRecord::make(std::uint32_t matchId, int roundNumber, std::uint64_t dealId,
+                              const GameRules& rules, const Hands& passes,
+                              const std::uint8_t plays[CARD_COUNT]) {
+    RoundRecord r;
+    std::memset(&r, 0, sizeof(r));
+    r.dealId = dealId;
+    r.matchId = matchId;
+    r.roundNumber = static_cast<std::uint8_t>(roundNumber);
+    r.rules = rules.flags();
+    r.endScore = static_cast<std::int16_t>(rules.endScore);
+
+    std::uint8_t passCards[12];
+    for (int seat = 0; seat < GameState::NUM_PLAYERS; ++seat) {
+        CardSet set = passes[seat];
+        for (int k = 0; k < 3; ++k) {
+            passCards[seat * 3 + k] = set ? static_cast<std::uint8_t>(popFirstCard(set)) : NO_CARD;
+        }
+    }
+    packCards(passCards, 12, r.passes);
+    packCards(plays, CARD_COUNT, r.plays);
+    return r;
+}
+
+int RoundRecord::play(int i) const {
+    return unpackCard(plays, i);
+}
+
+CardSet RoundRecord::passed(int seat) const {
+    CardSet set = 0;
+    for (int k = 0; k < 3; ++k) {
+        int card = unpackCard(passes, seat * 3 + k);
+        if (card != NO_CARD) set |= cardBit(card);
+    }
+    return set;
+}
+
+GameRules RoundRecord::gameRules() const {
+    GameRules r;
+    r.endScore = endScore;
+    r.queenBreaksHearts = rules & RuleQueenBreaksHearts;
+    r.moonProtection = rules & RuleMoonProtection;
+    r.fullPolish = rules & RuleFullPolish;
+    r.exactResetTo50 = rules & RuleExactResetTo50;
+    return r;
+}
+
+std::uint32_t recordChecksum(const void* data, std::size_t size) {
+    // CRC-32 (IEEE), table built once on first use
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t;
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+    std::uint32_t crc = 0xffffffffu;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc ^ 0xffffffffu;
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+GameRecordWriter::~GameRecordWriter() {
+    close();
+}
+
+bool GameRecordWriter::open(const std::string& path) {
+    close();
+
+    // Find the end of the last complete block so a torn tail gets overwritten.
+    // Headers are hopped with seeks; only the final block's checksum is read.
+    std::uintmax_t validEnd = 0;
+    bool exists = false;
+    bool foreign = false;
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    if (std::FILE* f = ec || fileSize == 0 ? nullptr : std::fopen(path.c_str(), "rb")) {
+        FileHeader fh;
+        if (std::fread(&fh, sizeof(fh), 1, f) == 1 && fh.magic == FILE_MAGIC &&
+            fh.version == FORMAT_VERSION && fh.recordSize == sizeof(RoundRecord)) {
+            exists = true;
+            validEnd = sizeof(fh);
+            std::uintmax_t lastBlock = 0;
+            BlockHeader bh, lastHeader;
+            while (std::fread(&bh, sizeof(bh), 1, f) == 1 && bh.magic == BLOCK_MAGIC) {
+                std::uintmax_t end = validEnd + sizeof(bh) + std::uintmax_t(bh.count) * sizeof(RoundRecord);
+                if (end > fileSize) break;
+                lastBlock = validEnd;
+                lastHeader = bh;
+                validEnd = end;
+                std::fseek(f, static_cast<long>(validEnd), SEEK_SET);
+            }
+            if (lastBlock) {
+                std::vector<RoundRecord> records(lastHeader.count);
+                std::fseek(f, static_cast<long>(lastBlock + sizeof(BlockHeader)), SEEK_SET);
+                if (std::fread(records.data(), sizeof(RoundRecord), records.size(), f) != records.size() ||
+                    recordChecksum(records.data(), records.size() * sizeof(RoundRecord)) != lastHeader.crc) {
+                    validEnd = lastBlock;
+                }
+            }
+        } else {
+            foreign = true;
+        }
+        std::fclose(f);
+    }
+
+    // Unreadable header, other version: keep those games, start a new file
+    if (foreign) {
+        std::string aside = path + ".old";
+        for (int n = 1; std::filesystem::exists(aside, ec); ++n) {
+            aside = path + ".old." + std::to_string(n);
+        }
+        std::filesystem::rename(path, aside, ec);
+        if (ec) return false;
+    }
+
+    if (exists) {
+        std::filesystem::resize_file(path, validEnd, ec);
+        if (ec) return false;
+        m_file = std::fopen(path.c_str(), "ab");
+    } else {
+        m_file = std::fopen(path.c_str(), "wb");
+        if (m_file) {
+            FileHeader fh = {FILE_MAGIC, FORMAT_VERSION, sizeof(RoundRecord), {0, 0}};
+            std::fwrite(&fh, sizeof(fh), 1, m_file);
+        }
+    }
+
+    m_pending.reserve(RECORDS_PER_BLOCK);
+    return m_file != nullptr;
+}
+
+void GameRecordWriter::append(const RoundRecord& record) {
+    m_pending.push_back(record);
+    if (m_pending.size() >= static_cast<std::size_t>(RECORDS_PER_BLOCK)) {
+        flush();
+    }
+}
+
+void GameRecordWriter::flush() {
+    if (!m_file || m_pending.empty()) return;
+
+    BlockHeader bh;
+    bh.magic = BLOCK_MAGIC;
+    bh.count = static_cast<std::uint32_t>(m_pending.size());
+    bh.crc = recordChecksum(m_pending.data(), m_pending.size() * sizeof(RoundRecord));
+    bh.reserved = 0;
+
+    std::fwrite(&bh, sizeof(bh), 1, m_file);
+    std::fwrite(m_pending.data(), sizeof(RoundRecord), m_pending.size(), m_file);
+    std::fflush(m_file);
+    m_pending.clear();
+}
+
+void GameRecordWriter::close() {
+    if (!m_file) return;
+    flush();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+GameRecordReader::~GameRecordReader() {
+    close();
+}
+
+bool GameRecordReader::open(const std::string& path) {
+    close();
+
+    auto file = std::make_unique<QFile>(QString::fromStdString(path));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < static_cast<qint64>(sizeof(FileHeader))) {
+        return false;
+    }
+
+    uchar* map = file->map(0, file->size());
+    if (!map) return false;
+
+    m_size = static_cast<std::size_t>(file->size());
+    m_data = map;
+    m_file = std::move(file);
+
+    const FileHeader* fh = reinterpret_cast<const FileHeader*>(m_data);
+    if (fh->magic != FILE_MAGIC || fh->version != FORMAT_VERSION || fh->recordSize != sizeof(RoundRecord)) {
+        close();
+        return false;
+    }
+
+    // Build the block index by hopping headers, checking each payload's CRC
+    std::size_t pos = sizeof(FileHeader);
+    while (pos + sizeof(BlockHeader) <= m_size) {
+        const BlockHeader* bh = reinterpret_cast<const BlockHeader*>(m_data + pos);
+        std::size_t payload = static_cast<std::size_t>(bh->count) * sizeof(RoundRecord);
+        if (bh->magic != BLOCK_MAGIC || pos + sizeof(BlockHeader) + payload > m_size) break;  // Torn tail
+
+        Block b;
+        b.records = reinterpret_cast<const RoundRecord*>(m_data + pos + sizeof(BlockHeader));
+        b.count = bh->count;
+        b.crc = bh->crc;
+        b.firstRound = m_roundCount;
+        pos += sizeof(BlockHeader) + payload;
+
+        // A corrupt block is left out; the blocks around it still read
+        if (recordChecksum(b.records, payload) != b.crc) {
+            m_skippedBlocks++;
+            continue;
+        }
+        m_blocks.push_back(b);
+        m_roundCount += bh->count;
+    }
+
+    return true;
+}
+
+void GameRecordReader::close() {
+    if (m_file) {
+        m_file->unmap(const_cast<unsigned char*>(m_data));
+        m_file.reset();
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_roundCount = 0;
+    m_skippedBlocks = 0;
+    m_blocks.clear();
+}
+
+const RoundRecord& GameRecordReader::round(std::size_t i) const {
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), i,
+                               [](std::size_t index, const Block& b) { return index < b.firstRound; });
+    const Block& b = *(it - 1);
+    return b.records[i - b.firstRound];
+}
+
+bool GameRecordReader::verifyBlock(std::size_t i) const {
+    const Block& b = m_blocks[i];
+    return recordChecksum(b.records, b.count * sizeof(RoundRecord)) == b.crc;
+}
@@ -0,0 +1,166 @@
+#include "gamestate.h"
+#include "rng.h"
+
+static int twoOfClubsHolder(const Hands& hands) {
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        if (hands[i] & cardBit(TWO_OF_CLUBS)) return i;
+    }
+    return 0;
+}
+
+GameState initialState(const GameRules& rules) {
+    GameState s{};
+    s.rules = rules.flags();
+    s.endScore = static_cast<std::int16_t>(rules.endScore);
+    return s;
+}
+
+GameState dealRound(const GameState& state, const Hands& hands) {
+    GameState s = state;
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        s.hands[i] = hands[i];
+        s.roundScores[i] = 0;
+    }
+    s.trickSize = 0;
+    s.tricksPlayed = 0;
+    s.heartsBroken = 0;
+    s.leadSuit = 0;
+    s.leader = static_cast<std::uint8_t>(twoOfClubsHolder(hands));
+    return s;
+}
+
+Hands dealHands(std::uint64_t dealId) {
+    std::uint8_t cards[CARD_COUNT];
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        cards[i] = static_cast<std::uint8_t>(i);
+    }
+    Rng rng(dealId);
+    shuffleRange(cards, cards + CARD_COUNT, rng);
+
+    // Consecutive runs of 13, like dealing off the top of the deck
+    Hands hands = {0, 0, 0, 0};
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        hands[i / SUIT_SIZE] |= cardBit(cards[i]);
+    }
+    return hands;
+}
+
+PassDirection passDirectionForRound(int round) {
+    switch ((round - 1) % 4) {
+        case 0: return PassDirection::Left;
+        case 1: return PassDirection::Right;
+        case 2: return PassDirection::Across;
+    }
+    return PassDirection::None;
+}
+
+int passTarget(int from, PassDirection dir) {
+    switch (dir) {
+        case PassDirection::Left:   return (from + 1) % GameState::NUM_PLAYERS;
+        case PassDirection::Right:  return (from + 3) % GameState::NUM_PLAYERS;
+        case PassDirection::Across: return (from + 2) % GameState::NUM_PLAYERS;
+        case PassDirection::None:   return from;
+    }
+    return from;
+}
+
+GameState applyPass(const GameState& state, const Hands& passed, PassDirection dir) {
+    GameState s = state;
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        s.hands[i] &= ~passed[i];
+    }
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        s.hands[passTarget(i, dir)] |= passed[i];
+    }
+    Hands hands = {s.hands[0], s.hands[1], s.hands[2], s.hands[3]};
+    s.leader = static_cast<std::uint8_t>(twoOfClubsHolder(hands));
+    return s;
+}
+
+CardSet legalMoves(const GameState& state) {
+    if (state.trickComplete()) return 0;
+
+    CardSet hand = state.hands[state.currentPlayer()];
+
+    if (state.trickSize == 0) {
+        // Opening lead must be 2♣
+        if (state.isFirstTrick() && (hand & cardBit(TWO_OF_CLUBS))) {
+            return cardBit(TWO_OF_CLUBS);
+        }
+        // Can lead anything except hearts (unless broken or only have hearts)
+        if (!state.heartsBroken && (hand & ~HEARTS_MASK)) {
+            return hand & ~HEARTS_MASK;
+        }
+        return hand;
+    }
+
+    // Must follow suit if possible
+    CardSet suited = hand & suitMask(state.leadSuit);
+    if (suited) return suited;
+
+    // No points on the first trick unless the hand holds nothing else
+    if (state.isFirstTrick() && (hand & ~POINT_CARDS)) {
+        return hand & ~POINT_CARDS;
+    }
+    return hand;
+}
+
+GameState applyMove(const GameState& state, int card) {
+    return roundEngine(state.rules).applyMove(state, card);
+}
+
+int trickWinner(const GameState& state) {
+    int best = 0;
+    for (int i = 1; i < state.trickSize; ++i) {
+        // Must follow lead suit to win
+        if (cardSuit(state.trick[i]) == state.leadSuit && state.trick[i] > state.trick[best]) {
+            best = i;
+        }
+    }
+    return state.trickPlayer(best);
+}
+
+int trickPoints(const GameState& state) {
+    int points = 0;
+    for (int i = 0; i < state.trickSize; ++i) {
+        points += cardPoints(state.trick[i]);
+    }
+    return points;
+}
+
+GameState collectTrick(const GameState& state) {
+    GameState s = state;
+    int winner = trickWinner(s);
+    s.roundScores[winner] += static_cast<std::int16_t>(trickPoints(s));
+    s.leader = static_cast<std::uint8_t>(winner);
+    s.trickSize = 0;
+    s.tricksPlayed++;
+    return s;
+}
+
+GameState scoreRound(const GameState& state, int* moonShooter) {
+    return roundEngine(state.rules).scoreRound(state, moonShooter);
+}
+
+bool matchOver(const GameState& state) {
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        if (state.totalScores[i] >= state.endScore) return true;
+    }
+    return false;
+}
+
+int matchWinner(const GameState& state) {
+    int winner = 0;
+    for (int i = 1; i < GameState::NUM_PLAYERS; ++i) {
+        if (state.totalScores[i] < state.totalScores[winner]) winner = i;
+    }
+    return winner;
+}
+
+const RoundEngine& roundEngine(std::uint8_t rules) {
+    return dispatchRules(rules, [](auto r) -> const RoundEngine& {
+        using R = decltype(r);
+        static const RoundEngine engine = {&applyMoveFor<R>, &scoreRoundFor<R>};
+        return engine;
+    });
+}
@@ -0,0 +1,98 @@
+#include "handmodel.h"
+
+HandModel::HandModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int HandModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant HandModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count()) return QVariant();
+
+    int card = cardAt(index.row());
+    switch (role) {
+        case SuitRole:      return cardSuit(card);
+        case RankRole:      return cardRankIndex(card) + 2;
+        case ElementIdRole: return cardElementId(card);
+        case PlayableRole:  return (m_playable & cardBit(card)) != 0;
+        case SelectedRole:  return (m_selected & cardBit(card)) != 0;
+        case ReceivedRole:  return (m_received & cardBit(card)) != 0;
+        default:            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> HandModel::roleNames() const {
+    return {
+        {SuitRole, "suit"},
+        {RankRole, "rank"},
+        {ElementIdRole, "elementId"},
+        {PlayableRole, "playable"},
+        {SelectedRole, "selected"},
+        {ReceivedRole, "received"}
+    };
+}
+
+int HandModel::indexOf(int suit, int rank) const {
+    if (suit < 0 || suit > 3 || rank < 2 || rank > 14) return -1;
+    int card = suit * SUIT_SIZE + rank - 2;
+    return (m_cards & cardBit(card)) ? rowOf(card) : -1;
+}
+
+int HandModel::cardAt(int row) const {
+    CardSet rest = m_cards;
+    for (int i = 0; i < row; ++i) rest &= rest - 1;
+    return firstCard(rest);
+}
+
+void HandModel::setCards(CardSet cards) {
+    if (cards == m_cards) return;
+
+    CardSet removed = m_cards & ~cards;
+    CardSet added = cards & ~m_cards;
+
+    if (removed == m_cards && m_cards) {
+        beginRemoveRows(QModelIndex(), 0, count() - 1);
+        m_cards = 0;
+        endRemoveRows();
+    } else {
+        // Highest first, so earlier rows keep their numbers
+        while (removed) {
+            int card = lastCard(removed);
+            removed &= ~cardBit(card);
+            int row = rowOf(card);
+            beginRemoveRows(QModelIndex(), row, row);
+            m_cards &= ~cardBit(card);
+            endRemoveRows();
+        }
+    }
+
+    if (!m_cards && added) {
+        beginInsertRows(QModelIndex(), 0, cardCount(added) - 1);
+        m_cards = added;
+        endInsertRows();
+    } else {
+        while (added) {
+            int card = popFirstCard(added);
+            int row = rowOf(card);
+            beginInsertRows(QModelIndex(), row, row);
+            m_cards |= cardBit(card);
+            endInsertRows();
+        }
+    }
+
+    emit countChanged();
+}
+
+void HandModel::setFlags(CardSet& flags, CardSet cards, int role) {
+    CardSet changed = (flags ^ cards) & m_cards;
+    flags = cards;
+
+    const QVector<int> roles = {role};
+    while (changed) {
+        QModelIndex at = index(rowOf(popFirstCard(changed)));
+        emit dataChanged(at, at, roles);
+    }
+}
@@ -4,12 +4,33 @@
 #include <QMainWindow>
 #include <QQuickWidget>
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QQuickStyle>
 #include <QMenuBar>
+#include <QFileDialog>
+#include <QFile>
 #include <QSurfaceFormat>
 #include <QIcon>
 #include <QKeyEvent>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <cstdio>
+#include <memory>
+#include <QWindow>
+
+// --bench-cards: warm-up before recording, then the recorded run
+static const int BENCH_WARMUP_MS = 2000;
+static const int BENCH_RUN_MS = 20000;
+
+// Resident set size in kB, or -1 where /proc isn't available
+static qint64 residentKb() {
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) return -1;
+    for (const QByteArray& line : status.readAll().split('\n')) {
+        if (line.startsWith("VmRSS:")) return line.mid(6).trimmed().split(' ').first().toLongLong();
+    }
+    return -1;
+}
 
 // Intercept Alt key to show the hidden menu bar
 class Application : public QApplication {
@@ -47,6 +68,9 @@ private:
 };
 
 int main(int argc, char* argv[]) {
+    QElapsedTimer startup;
+    startup.start();
+
     // MSAA for smooth card edges
     QSurfaceFormat format = QSurfaceFormat::defaultFormat();
     format.setSamples(4);
@@ -75,11 +99,51 @@ int main(int argc, char* argv[]) {
     quickWidget->setFormat(format);
     quickWidget->setResizeMode(QQuickWidget::SizeRootObjectToView);
 
-    quickWidget->engine()->addImageProvider("cards", new CardImageProvider(gameBridge->theme()));
-    quickWidget->engine()->addImageProvider("cardpreview", new CardImageProvider(gameBridge->previewTheme()));
+    quickWidget->engine()->addImageProvider("cards", new CardImageProvider(gameBridge->theme(), gameBridge->perfMonitor()));
+    quickWidget->engine()->addImageProvider("cardpreview", new CardImageProvider(gameBridge->previewTheme(), gameBridge->perfMonitor()));
+
     quickWidget->rootContext()->setContextProperty("gameBridge", gameBridge);
 
-    quickWidget->setSource(QUrl("qrc:/qml/Main.qml"));
+    // --bench-cards [legacy] shows CardBench.qml instead of the game: after a
+    // warm-up it records BENCH_RUN_MS of frames, prints the percentiles and
+    // resident memory, writes every sample with dumpCsv and quits
+    int benchArg = app.arguments().indexOf("--bench-cards");
+    bool bench = benchArg >= 0;
+    quickWidget->rootContext()->setContextProperty("benchLegacy", app.arguments().value(benchArg + 1) == "legacy");
+    quickWidget->setSource(QUrl(bench ? "qrc:/qml/CardBench.qml" : "qrc:/qml/Main.qml"));
+    gameBridge->setWindow(quickWidget->quickWindow());
+
+    if (bench) {
+        PerfMonitor* perf = gameBridge->perfMonitor();
+        perf->setEnabled(true);
+        QTimer::singleShot(BENCH_WARMUP_MS, perf, &PerfMonitor::reset);
+        QTimer::singleShot(BENCH_WARMUP_MS + BENCH_RUN_MS, perf, [perf]() {
+            for (const QVariant& v : perf->summary()) {
+                QVariantMap row = v.toMap();
+                if (row["count"].toInt() == 0) continue;
+                std::printf("%-14s %6d samples  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms\n",
+                            qPrintable(row["name"].toString()), row["count"].toInt(), row["p50"].toDouble(),
+                            row["p95"].toDouble(), row["p99"].toDouble(), row["max"].toDouble());
+            }
+            std::printf("resident %lld kB\n", static_cast<long long>(residentKb()));
+            std::printf("samples in %s\n", qPrintable(perf->dumpCsv()));
+            QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+        });
+    }
+
+    // Time to first frame, shown in the performance overlay; --startup-time
+    // prints it and quits, for measuring cold starts from scripts
+    bool reportStartup = app.arguments().contains("--startup-time");
+    auto firstFrame = std::make_shared<QMetaObject::Connection>();
+    *firstFrame = QObject::connect(quickWidget->quickWindow(), &QQuickWindow::afterFrameEnd, gameBridge,
+                                   [firstFrame, &startup, gameBridge, reportStartup]() {
+        QObject::disconnect(*firstFrame);
+        gameBridge->perfMonitor()->setStartupMs(startup.elapsed());
+        if (reportStartup) {
+            std::printf("first frame after %lld ms\n", static_cast<long long>(startup.elapsed()));
+            QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+        }
+    });
 
     mainWindow.setCentralWidget(quickWidget);
 
@@ -90,6 +154,7 @@ int main(int argc, char* argv[]) {
     QMenu* gameMenu = menuBar->addMenu(QObject::tr("&Game"));
     QAction* newGameAction = gameMenu->addAction(QObject::tr("&New Game"), gameBridge, &GameBridge::newGame);
     newGameAction->setShortcut(QKeySequence("Ctrl+N"));
+    gameMenu->addAction(QObject::tr("Play &Seed..."), gameBridge, &GameBridge::openSeedRequested);
     gameMenu->addSeparator();
     QAction* undoAction = gameMenu->addAction(QObject::tr("&Undo"), gameBridge, &GameBridge::undo);
     undoAction->setShortcut(QKeySequence("Ctrl+Z"));
@@ -106,6 +171,18 @@ int main(int argc, char* argv[]) {
     viewMenu->addAction(QObject::tr("&Scores..."), gameBridge, &GameBridge::openScoresRequested);
     viewMenu->addAction(QObject::tr("S&tatistics..."), gameBridge, &GameBridge::openStatisticsRequested);
     viewMenu->addSeparator();
+    QAction* replayAction = viewMenu->addAction(QObject::tr("&Replay Last Match"), gameBridge, [gameBridge]() {
+        gameBridge->openReplay();
+    });
+    replayAction->setShortcut(QKeySequence("Ctrl+R"));
+    viewMenu->addAction(QObject::tr("Open Replay &File..."), &mainWindow, [&mainWindow, gameBridge]() {
+        QString path = QFileDialog::getOpenFileName(&mainWindow, QObject::tr("Open Replay"), QString(),
+                                                    QObject::tr("Game records (*.hrec)"));
+        if (!path.isEmpty()) {
+            gameBridge->openReplay(path);
+        }
+    });
+    viewMenu->addSeparator();
     QAction* fullscreenAction = viewMenu->addAction(QObject::tr("&Fullscreen"));
     fullscreenAction->setShortcut(QKeySequence("F11"));
     fullscreenAction->setCheckable(true);
@@ -116,6 +193,12 @@ int main(int argc, char* argv[]) {
             mainWindow.showNormal();
         }
     });
+    QAction* perfAction = viewMenu->addAction(QObject::tr("&Performance Overlay"));
+    perfAction->setCheckable(true);
+    QObject::connect(perfAction, &QAction::toggled, gameBridge->perfMonitor(), &PerfMonitor::setEnabled);
+    QObject::connect(gameBridge->perfMonitor(), &PerfMonitor::enabledChanged, perfAction, [perfAction, gameBridge]() {
+        perfAction->setChecked(gameBridge->perfMonitor()->enabled());
+    });
     viewMenu->addSeparator();
     QAction* menuBarAction = viewMenu->addAction(QObject::tr("Show &Menu Bar"));
     menuBarAction->setShortcut(QKeySequence("Ctrl+M"));
@@ -145,6 +228,7 @@ int main(int argc, char* argv[]) {
     // Add all shortcut actions to the window so they work when menu bar is hidden
     mainWindow.addAction(newGameAction);
     mainWindow.addAction(undoAction);
+    mainWindow.addAction(replayAction);
     mainWindow.addAction(quitAction);
     mainWindow.addAction(fullscreenAction);
     mainWindow.addAction(menuBarAction);
@@ -167,5 +251,11 @@ int main(int argc, char* argv[]) {
 
     mainWindow.show();
 
+    // Nobody watches a minimized table: skip its animations
+    QObject::connect(mainWindow.windowHandle(), &QWindow::visibilityChanged, gameBridge,
+                     [gameBridge](QWindow::Visibility visibility) {
+        gameBridge->setWindowHidden(visibility == QWindow::Minimized || visibility == QWindow::Hidden);
+    });
+
     return app.exec();
 }
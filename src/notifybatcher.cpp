@@ -0,0 +1,39 @@
+#include "notifybatcher.h"
+#include <QQuickWindow>
+#include <QTimer>
+
+NotifyBatcher::NotifyBatcher(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void NotifyBatcher::setWindow(QQuickWindow* window) {
+    if (m_window) disconnect(m_window, nullptr, this, nullptr);
+    m_window = window;
+    if (m_window) {
+        connect(m_window, &QQuickWindow::beforeSynchronizing, this, &NotifyBatcher::flush, Qt::DirectConnection);
+    }
+    m_scheduled = false;
+    if (m_pending) mark(0);
+}
+
+void NotifyBatcher::mark(quint32 bits) {
+    m_pending |= bits;
+    if (m_scheduled || !m_pending) return;
+    m_scheduled = true;
+
+    if (m_window) {
+        // Make sure a frame comes even if nothing else on screen changed
+        m_window->update();
+    } else {
+        QTimer::singleShot(0, this, &NotifyBatcher::flush);
+    }
+}
+
+void NotifyBatcher::flush() {
+    m_scheduled = false;
+    // Handlers may mark more bits; those wait for the next frame
+    quint32 bits = m_pending;
+    m_pending = 0;
+    if (bits) emit flushed(bits);
+}
@@ -0,0 +1,9 @@
+#include "alloccounter.h"
+
+// Default for everything that links hearts-core: no counting, and the
+// global operator new stays the standard one. Targets that want counts
+// link the alloccounter object library, whose definition wins over this
+// archive member.
+std::uint64_t heapAllocationCount() {
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "perfmonitor.h"
+#include "cardtheme.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <algorithm>
+
+static const char* const METRIC_NAMES[PerfMonitor::MetricCount] = {
+    "frame", "sync", "render", "image", "atlas", "ai", "input"
+};
+
+PerfMonitor::PerfMonitor(QObject* parent)
+    : QObject(parent)
+{
+    for (Ring& ring : m_rings) ring.samples.resize(SAMPLES);
+    m_clock.start();
+    m_summaryTimer.setInterval(SUMMARY_INTERVAL);
+    connect(&m_summaryTimer, &QTimer::timeout, this, &PerfMonitor::updateSummary);
+}
+
+const char* PerfMonitor::metricName(Metric metric) {
+    return METRIC_NAMES[metric];
+}
+
+void PerfMonitor::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    m_lastSwap = -1;
+    m_inputAt = -1;
+    if (m_enabled) {
+        connectWindow();
+        m_summaryTimer.start();
+    } else {
+        for (const QMetaObject::Connection& c : m_connections) disconnect(c);
+        m_connections.clear();
+        m_summaryTimer.stop();
+    }
+    emit enabledChanged();
+}
+
+void PerfMonitor::setStartupMs(qint64 ms) {
+    m_startupMs = ms;
+    emit startupMsChanged();
+}
+
+void PerfMonitor::setWindow(QQuickWindow* window) {
+    for (const QMetaObject::Connection& c : m_connections) disconnect(c);
+    m_connections.clear();
+    m_window = window;
+    if (m_enabled) connectWindow();
+}
+
+// The window's signals arrive on the render thread; connect directly
+void PerfMonitor::connectWindow() {
+    if (!m_window) return;
+    auto hook = [this](auto signal, auto slot) {
+        m_connections.append(connect(m_window.data(), signal, this, slot, Qt::DirectConnection));
+    };
+
+    // A QQuickWidget renders its window offscreen through a render control,
+    // which never swaps; its frames end at afterFrameEnd instead
+    auto frameDone = QQuickRenderControl::renderWindowFor(m_window) ? &QQuickWindow::afterFrameEnd
+                                                                    : &QQuickWindow::frameSwapped;
+    hook(frameDone, [this]() {
+        qint64 now = m_clock.nsecsElapsed();
+        if (m_lastSwap >= 0) record(FrameTime, now - m_lastSwap);
+        m_lastSwap = now;
+
+        qint64 input = m_inputAt.exchange(-1);
+        if (input >= 0) record(InputLatency, now - input);
+    });
+    hook(&QQuickWindow::beforeSynchronizing, [this]() { m_syncStart = m_clock.nsecsElapsed(); });
+    hook(&QQuickWindow::afterSynchronizing, [this]() { record(SyncTime, m_clock.nsecsElapsed() - m_syncStart); });
+    hook(&QQuickWindow::beforeRendering, [this]() { m_renderStart = m_clock.nsecsElapsed(); });
+    hook(&QQuickWindow::afterRendering, [this]() { record(RenderTime, m_clock.nsecsElapsed() - m_renderStart); });
+}
+
+void PerfMonitor::record(Metric metric, qint64 nsecs) {
+    if (!m_enabled) return;
+    QMutexLocker lock(&m_mutex);
+    Ring& ring = m_rings[metric];
+    ring.samples[ring.next] = {m_clock.nsecsElapsed(), nsecs};
+    if (++ring.next == SAMPLES) {
+        ring.next = 0;
+        ring.full = true;
+    }
+}
+
+void PerfMonitor::markInput() {
+    if (!m_enabled) return;
+    // Keep the earliest unanswered input
+    qint64 expected = -1;
+    m_inputAt.compare_exchange_strong(expected, m_clock.nsecsElapsed());
+}
+
+void PerfMonitor::reset() {
+    {
+        QMutexLocker lock(&m_mutex);
+        for (Ring& ring : m_rings) {
+            ring.next = 0;
+            ring.full = false;
+        }
+    }
+    updateSummary();
+}
+
+void PerfMonitor::updateSummary() {
+    QVector<qint64> values;
+    QVariantList summary;
+    for (int m = 0; m < MetricCount; ++m) {
+        {
+            QMutexLocker lock(&m_mutex);
+            const Ring& ring = m_rings[m];
+            int count = ring.full ? SAMPLES : ring.next;
+            values.resize(count);
+            for (int i = 0; i < count; ++i) values[i] = ring.samples[i].value;
+        }
+
+        QVariantMap row;
+        row["name"] = QString::fromLatin1(METRIC_NAMES[m]);
+        row["count"] = values.size();
+        if (!values.isEmpty()) {
+            auto percentile = [&values](double p) {
+                auto nth = values.begin() + std::min<qsizetype>(values.size() - 1, qsizetype(p * values.size()));
+                std::nth_element(values.begin(), nth, values.end());
+                return *nth / 1e6;
+            };
+            row["p50"] = percentile(0.50);
+            row["p95"] = percentile(0.95);
+            row["p99"] = percentile(0.99);
+            row["max"] = *std::max_element(values.begin(), values.end()) / 1e6;
+        }
+        summary.append(row);
+    }
+    m_summary = summary;
+
+    if (m_cardTheme) {
+        CardCacheStats stats = m_cardTheme->cacheStats();
+        m_cardCache["images"] = stats.images;
+        m_cardCache["bytes"] = stats.bytes;
+        m_cardCache["budget"] = stats.budget;
+        m_cardCache["hits"] = stats.hits;
+        m_cardCache["misses"] = stats.misses;
+    }
+    emit summaryChanged();
+}
+
+QString PerfMonitor::dumpCsv(const QString& path) const {
+    QString target = path;
+    if (target.isEmpty()) {
+        QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(dir);
+        target = dir + "/perf-" + QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss") + ".csv";
+    }
+
+    QFile file(target);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) return QString();
+
+    QTextStream out(&file);
+    out << "metric,time_ms,value_ms\n";
+    QMutexLocker lock(&m_mutex);
+    for (int m = 0; m < MetricCount; ++m) {
+        const Ring& ring = m_rings[m];
+        int count = ring.full ? SAMPLES : ring.next;
+        int first = ring.full ? ring.next : 0;
+        for (int i = 0; i < count; ++i) {
+            const Sample& s = ring.samples[(first + i) % SAMPLES];
+            out << METRIC_NAMES[m] << ',' << QString::number(s.at / 1e6, 'f', 3) << ','
+                << QString::number(s.value / 1e6, 'f', 3) << '\n';
+        }
+    }
+    out.flush();
+    return file.error() == QFileDevice::NoError ? target : QString();
+}
@@ -0,0 +1,344 @@
+#include "aidecision.h"
+#include "card.h"
+#include "cardcodes.h"
+#include "gamestate.h"
+#include "simulate.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// hearts-perft: counts the leaf nodes of the card-play tree from a deal to
+// a given depth (in cards played), chess-perft style. The counts pin down
+// the move generator; the timings benchmark it.
+
+static const int SPLIT_DEPTH = 2;  // Root plies expanded into parallel tasks
+
+using Clock = std::chrono::steady_clock;
+
+template <typename R>
+static std::uint64_t perft(const GameState& s, int depth) {
+    CardSet moves = legalMoves(s);
+    if (depth == 1) return static_cast<std::uint64_t>(cardCount(moves));
+
+    std::uint64_t nodes = 0;
+    while (moves) {
+        GameState next = applyMoveFor<R>(s, popFirstCard(moves));
+        if (next.trickComplete()) next = collectTrick(next);
+        nodes += perft<R>(next, depth - 1);
+    }
+    return nodes;
+}
+
+// Positions `depth` plies below `s`
+template <typename R>
+static void expand(const GameState& s, int depth, std::vector<GameState>& out) {
+    if (depth == 0) {
+        out.push_back(s);
+        return;
+    }
+    CardSet moves = legalMoves(s);
+    while (moves) {
+        GameState next = applyMoveFor<R>(s, popFirstCard(moves));
+        if (next.trickComplete()) next = collectTrick(next);
+        expand<R>(next, depth - 1, out);
+    }
+}
+
+template <typename R>
+static std::uint64_t parallelPerft(const GameState& root, int depth, int threads) {
+    if (depth <= SPLIT_DEPTH || threads <= 1) return perft<R>(root, depth);
+
+    std::vector<GameState> tasks;
+    expand<R>(root, SPLIT_DEPTH, tasks);
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::uint64_t> total{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            std::uint64_t nodes = 0;
+            for (std::size_t i = next++; i < tasks.size(); i = next++) {
+                nodes += perft<R>(tasks[i], depth - SPLIT_DEPTH);
+            }
+            total += nodes;
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    return total;
+}
+
+// ============================================================================
+// VERIFY
+// ============================================================================
+
+// Independent reference for the rules, written the way the game was before
+// the bitboard core: card lists and Card predicates, nothing from
+// gamestate.h. --verify walks it in lockstep with legalMoves()/applyMove().
+struct ReferencePosition {
+    Cards hands[GameState::NUM_PLAYERS];
+    Cards trick;                 // In play order, trick[0] played by leader
+    int leader = 0;
+    int tricksPlayed = 0;
+    bool heartsBroken = false;
+    bool queenBreaksHearts = true;
+    int points[GameState::NUM_PLAYERS] = {};
+
+    int current() const { return (leader + trick.size()) % GameState::NUM_PLAYERS; }
+
+    Cards moves() const {
+        const Cards& hand = hands[current()];
+        Cards valid;
+
+        if (trick.isEmpty()) {
+            // Opening lead is the 2 of clubs
+            if (tricksPlayed == 0) {
+                for (const Card& c : hand) {
+                    if (c.isTwoOfClubs()) return Cards{c};
+                }
+            }
+            // No hearts until broken, unless the hand is all hearts
+            if (!heartsBroken) {
+                for (const Card& c : hand) {
+                    if (!c.isHeart()) valid.append(c);
+                }
+                if (!valid.isEmpty()) return valid;
+            }
+            return hand;
+        }
+
+        // Must follow suit if possible
+        Cards suited = cardsOfSuit(hand, trick.first().suit());
+        if (!suited.isEmpty()) return suited;
+
+        // No points on the first trick, unless the hand holds nothing else
+        if (tricksPlayed == 0) {
+            for (const Card& c : hand) {
+                if (!c.isPointCard()) valid.append(c);
+            }
+            if (!valid.isEmpty()) return valid;
+        }
+        return hand;
+    }
+
+    ReferencePosition play(const Card& card) const {
+        ReferencePosition next = *this;
+        next.hands[current()].removeOne(card);
+        next.trick.append(card);
+        if (card.isHeart() || (queenBreaksHearts && card.isQueenOfSpades())) next.heartsBroken = true;
+
+        if (next.trick.size() == GameState::NUM_PLAYERS) {
+            int best = 0;
+            int taken = 0;
+            for (int i = 0; i < next.trick.size(); ++i) {
+                const Card& c = next.trick[i];
+                if (c.suit() == next.trick.first().suit() && c.rank() > next.trick[best].rank()) best = i;
+                taken += c.pointValue();
+            }
+            next.leader = (leader + best) % GameState::NUM_PLAYERS;
+            next.points[next.leader] += taken;
+            next.trick.clear();
+            next.tricksPlayed++;
+        }
+        return next;
+    }
+};
+
+// Walks the tree comparing the core with ReferencePosition at every node:
+// legal moves, the player to move, hands, hearts broken and points taken
+struct Verifier {
+    std::uint64_t positions = 0;
+    std::uint64_t mismatches = 0;
+
+    void report(const GameState& s, const char* what, const std::string& core, const std::string& reference) {
+        if (mismatches++ < 10) {
+            std::printf("mismatch in %s: trick %d card %d, hand %s: core {%s} reference {%s}\n", what,
+                        s.tricksPlayed + 1, s.trickSize + 1, cardCodes(s.hands[s.currentPlayer()]).c_str(),
+                        core.c_str(), reference.c_str());
+        }
+    }
+
+    void walk(const GameState& s, const ReferencePosition& ref, int depth) {
+        positions++;
+        if (s.currentPlayer() != ref.current()) {
+            report(s, "player to move", std::to_string(s.currentPlayer()), std::to_string(ref.current()));
+            return;
+        }
+        if (s.hands[s.currentPlayer()] != toCardSet(ref.hands[ref.current()])) {
+            report(s, "hand", cardCodes(s.hands[s.currentPlayer()]),
+                   cardCodes(toCardSet(ref.hands[ref.current()])));
+            return;
+        }
+        if (bool(s.heartsBroken) != ref.heartsBroken) {
+            report(s, "hearts broken", std::to_string(s.heartsBroken), std::to_string(ref.heartsBroken));
+        }
+        for (int seat = 0; seat < GameState::NUM_PLAYERS; ++seat) {
+            if (s.roundScores[seat] != ref.points[seat]) {
+                report(s, "points", std::to_string(s.roundScores[seat]), std::to_string(ref.points[seat]));
+                break;
+            }
+        }
+
+        CardSet core = legalMoves(s);
+        CardSet reference = toCardSet(ref.moves());
+        if (core != reference) {
+            report(s, "legal moves", cardCodes(core), cardCodes(reference));
+            return;
+        }
+
+        if (depth == 0) return;
+        while (core) {
+            int card = popFirstCard(core);
+            GameState next = applyMove(s, card);
+            if (next.trickComplete()) next = collectTrick(next);
+            walk(next, ref.play(Card::fromIndex(card)), depth - 1);
+        }
+    }
+};
+
+// ============================================================================
+// ROLLOUTS
+// ============================================================================
+
+// Plays `count` full rounds with random policies through simulateRound(),
+// one fresh deal per rollout, and reports the cost per round
+static void benchmarkRollouts(std::uint64_t dealId, long count, int threads, const GameRules& rules) {
+    std::atomic<long> next{0};
+    std::atomic<long> moons{0};
+    std::vector<std::thread> workers;
+
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            RandomPolicy policy(deriveSeed(dealId, 1000 + t));
+            long shot = 0;
+            for (long i = next++; i < count; i = next++) {
+                Hands deal = dealHands(deriveSeed(dealId, static_cast<std::uint64_t>(i)));
+                if (simulateRound(deal, policy, rules).moonShooter >= 0) shot++;
+            }
+            moons += shot;
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("%ld rollouts in %.3f s: %.0f ns/round/thread, %.0f rounds/s, %ld moon shots\n", count, seconds,
+                seconds * 1e9 * threads / count, count / seconds, moons.load());
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void usage() {
+    std::fprintf(stderr,
+        "Usage: hearts-perft [options] DEPTH\n"
+        "  --seed N      Match seed to deal from (default: 1)\n"
+        "  --round N     Round of that match to deal (default: 1; no passing is applied)\n"
+        "  --deal ID     Deal ID to use directly instead of --seed/--round\n"
+        "  --threads N   Worker threads (default: one per core)\n"
+        "  --rules BITS  RuleFlag bits (default: 1)\n"
+        "  --verify      Also check the core against a list-based reference at every node\n"
+        "  --rollouts N  Instead of perft, time N random-play rounds through simulateRound\n");
+}
+
+int main(int argc, char* argv[]) {
+    std::uint64_t seed = 1;
+    int round = 1;
+    bool haveDeal = false;
+    std::uint64_t dealId = 0;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    unsigned rules = RuleQueenBreaksHearts;
+    bool verify = false;
+    long rollouts = 0;
+    int depth = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--seed") == 0 && value) {
+            seed = std::strtoull(value, nullptr, 0);
+            ++i;
+        } else if (std::strcmp(arg, "--round") == 0 && value) {
+            round = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--deal") == 0 && value) {
+            dealId = std::strtoull(value, nullptr, 0);
+            haveDeal = true;
+            ++i;
+        } else if (std::strcmp(arg, "--threads") == 0 && value) {
+            threads = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--rules") == 0 && value) {
+            rules = static_cast<unsigned>(std::strtoul(value, nullptr, 0)) & 0x0f;
+            ++i;
+        } else if (std::strcmp(arg, "--rollouts") == 0 && value) {
+            rollouts = std::atol(value);
+            ++i;
+        } else if (std::strcmp(arg, "--verify") == 0) {
+            verify = true;
+        } else if (arg[0] != '-' && depth < 0) {
+            depth = std::atoi(arg);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (rollouts > 0 && depth < 0) depth = 1;
+    if (depth < 1 || depth > CARD_COUNT || round < 1) {
+        usage();
+        return 2;
+    }
+    if (threads < 1) threads = 1;
+    if (!haveDeal) dealId = dealIdForRound(seed, round);
+
+    GameRules gameRules;
+    gameRules.queenBreaksHearts = rules & RuleQueenBreaksHearts;
+    gameRules.moonProtection = rules & RuleMoonProtection;
+    gameRules.fullPolish = rules & RuleFullPolish;
+    gameRules.exactResetTo50 = rules & RuleExactResetTo50;
+    if (rollouts > 0) {
+        benchmarkRollouts(dealId, rollouts, threads, gameRules);
+        return 0;
+    }
+
+    GameState root = dealRound(initialState(gameRules), dealHands(dealId));
+
+    std::printf("deal 0x%016llx, %d thread(s)\n", static_cast<unsigned long long>(dealId), threads);
+    for (int seat = 0; seat < GameState::NUM_PLAYERS; ++seat) {
+        std::printf("  seat %d%s: %s\n", seat, seat == root.leader ? " (leads)" : "",
+                    cardCodes(root.hands[seat]).c_str());
+    }
+    std::printf("\n%5s %20s %10s %12s\n", "depth", "nodes", "seconds", "Mnodes/s");
+
+    dispatchRules(root.rules, [&](auto r) {
+        using R = decltype(r);
+        for (int d = 1; d <= depth; ++d) {
+            Clock::time_point start = Clock::now();
+            std::uint64_t nodes = parallelPerft<R>(root, d, threads);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::printf("%5d %20llu %10.3f %12.2f\n", d, static_cast<unsigned long long>(nodes), seconds,
+                        seconds > 0 ? nodes / seconds / 1e6 : 0.0);
+            std::fflush(stdout);
+        }
+    });
+
+    if (verify) {
+        ReferencePosition ref;
+        for (int seat = 0; seat < GameState::NUM_PLAYERS; ++seat) ref.hands[seat] = fromCardSet(root.hands[seat]);
+        ref.leader = root.leader;
+        ref.queenBreaksHearts = root.hasRule(RuleQueenBreaksHearts);
+
+        Verifier verifier;
+        verifier.walk(root, ref, depth - 1);
+        std::printf("\nverify: %llu positions, %llu mismatches\n",
+                    static_cast<unsigned long long>(verifier.positions),
+                    static_cast<unsigned long long>(verifier.mismatches));
+        if (verifier.mismatches) return 1;
+    }
+    return 0;
+}
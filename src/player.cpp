@@ -1,12 +1,6 @@
 #include "player.h"
+#include "gamestate.h"
 #include <algorithm>
-#include <chrono>
-
-// Static RNG shared across all AI decisions - seeded once
-std::mt19937& Player::rng() {
-    static std::mt19937 instance(std::chrono::steady_clock::now().time_since_epoch().count());
-    return instance;
-}
 
 Player::Player(int id, const QString& name, bool isHuman)
     : m_id(id), m_name(name), m_isHuman(isHuman), m_roundScore(0), m_totalScore(0), m_difficulty(AIDifficulty::Medium) {}
@@ -49,40 +43,16 @@ void Player::resetScores() {
     m_totalScore = 0;
 }
 
-Cards Player::getValidPlays(Suit leadSuit, bool isFirstTrick, bool heartsBroken) const {
-    Cards valid;
-
-    // First card of first trick must be 2 of clubs
-    if (isFirstTrick && leadSuit == Suit::Clubs) {
-        Card twoClubs(Suit::Clubs, Rank::Two);
-        if (hasCard(twoClubs)) {
-            valid.append(twoClubs);
-            return valid;
-        }
-    }
-
-    // Must follow suit if possible
-    Cards suited = cardsOfSuit(m_hand, leadSuit);
-    if (!suited.isEmpty()) {
-        return suited;
-    }
-
-    // Can't follow suit - can play anything except:
-    // - On first trick, can't play hearts or QoS (unless only have those)
-    if (isFirstTrick) {
-        for (const Card& c : m_hand) {
-            if (!c.isPointCard()) {
-                valid.append(c);
-            }
-        }
-        if (valid.isEmpty()) {
-            return m_hand; // Only have point cards
-        }
-        return valid;
-    }
-
-    // Not first trick, can play anything
-    return m_hand;
+Cards Player::getValidPlays(Suit leadSuit, bool leading, bool isFirstTrick, bool heartsBroken) const {
+    // Same rules as the core: pose the position from this seat's view
+    GameState s{};
+    s.leader = 0;
+    s.trickSize = leading ? 0 : 1;
+    s.leadSuit = static_cast<std::uint8_t>(leadSuit);
+    s.tricksPlayed = isFirstTrick ? 0 : 1;
+    s.heartsBroken = heartsBroken;
+    s.hands[s.currentPlayer()] = toCardSet(m_hand);
+    return fromCardSet(legalMoves(s));
 }
 
 // ============================================================================
@@ -100,10 +70,9 @@ Cards Player::selectPassCards() {
     Cards remaining = m_hand;
 
     // Sort by "danger level"
-    std::sort(remaining.begin(), remaining.end(), [](const Card& a, const Card& b) {
+    std::stable_sort(remaining.begin(), remaining.end(), [](const Card& a, const Card& b) {
         // QoS is most dangerous
-        if (a.isQueenOfSpades()) return true;
-        if (b.isQueenOfSpades()) return false;
+        if (a.isQueenOfSpades() != b.isQueenOfSpades()) return a.isQueenOfSpades();
 
         // Ace/King of spades are dangerous (can catch QoS)
         bool aHighSpade = a.suit() == Suit::Spades && a.rank() >= Rank::King;
@@ -177,7 +146,7 @@ Cards Player::selectPassCardsHard() {
                 lowCards.append(c);
             }
         }
-        std::sort(lowCards.begin(), lowCards.end(), [](const Card& a, const Card& b) {
+        std::stable_sort(lowCards.begin(), lowCards.end(), [](const Card& a, const Card& b) {
             return a.rank() < b.rank();
         });
         for (const Card& c : lowCards) {
@@ -218,7 +187,7 @@ Cards Player::selectPassCardsHard() {
 
     // High hearts
     Cards highHeartCards = cardsOfSuit(m_hand, Suit::Hearts);
-    std::sort(highHeartCards.begin(), highHeartCards.end(), [](const Card& a, const Card& b) {
+    std::stable_sort(highHeartCards.begin(), highHeartCards.end(), [](const Card& a, const Card& b) {
         return a.rank() > b.rank();
     });
     for (const Card& h : highHeartCards) {
@@ -249,7 +218,7 @@ Cards Player::selectPassCardsHard() {
     // Fill remaining with highest cards (non-spade if we're protecting Q♠)
     if (toPass.size() < 3) {
         Cards candidates = remaining;
-        std::sort(candidates.begin(), candidates.end(), [keepQoS](const Card& a, const Card& b) {
+        std::stable_sort(candidates.begin(), candidates.end(), [keepQoS](const Card& a, const Card& b) {
             // If protecting spades, deprioritize them
             if (keepQoS) {
                 if (a.suit() == Suit::Spades && b.suit() != Suit::Spades) return false;
@@ -275,7 +244,7 @@ Cards Player::selectPassCardsHard() {
 
 Card Player::selectPlay(Suit leadSuit, bool isFirstTrick, bool heartsBroken,
                         const Cards& trickCards, const QVector<int>& trickPlayers) {
-    Cards valid = getValidPlays(leadSuit, isFirstTrick, heartsBroken);
+    Cards valid = getValidPlays(leadSuit, trickCards.isEmpty(), isFirstTrick, heartsBroken);
 
     if (valid.isEmpty()) {
         return m_hand.first(); // Shouldn't happen
@@ -323,25 +292,22 @@ Card Player::selectPlay(Suit leadSuit, bool isFirstTrick, bool heartsBroken,
 
 Card Player::aiSelectLeadEasy(const Cards& valid) {
     // Easy: 50% random, 50% highest card (bad strategy)
-    if (std::uniform_int_distribution<>(0, 1)(rng()) == 0) {
-        std::uniform_int_distribution<> dist(0, valid.size() - 1);
-        return valid[dist(rng())];
+    if (m_rng.below(2) == 0) {
+        return valid[m_rng.below(static_cast<int>(valid.size()))];
     }
     return highestCard(valid);
 }
 
 Card Player::aiSelectFollowEasy(const Cards& valid) {
     // Easy: Play random card when following suit
-    std::uniform_int_distribution<> dist(0, valid.size() - 1);
-    return valid[dist(rng())];
+    return valid[m_rng.below(static_cast<int>(valid.size()))];
 }
 
 Card Player::aiSelectSloughEasy(const Cards& valid) {
     // Easy: Just plays high cards randomly, no strategic thinking about Q♠ or spades
     // 50% chance to play a random card, 50% chance to play highest card
-    if (std::uniform_int_distribution<>(0, 1)(rng()) == 0) {
-        std::uniform_int_distribution<> dist(0, valid.size() - 1);
-        return valid[dist(rng())];
+    if (m_rng.below(2) == 0) {
+        return valid[m_rng.below(static_cast<int>(valid.size()))];
     }
     return highestCard(valid);
 }
@@ -361,7 +327,7 @@ Card Player::aiSelectLead(const Cards& valid, bool heartsBroken) {
         Card lowSpade = lowestOfSuit(valid, Suit::Spades);
         if (lowSpade.isValid() && lowSpade.rank() < Rank::Queen) {
             // 40% chance to lead low spade to flush Q♠ (medium isn't as aggressive)
-            if (std::uniform_int_distribution<>(0, 4)(rng()) < 2) {
+            if (m_rng.below(5) < 2) {
                 return lowSpade;
             }
         }
@@ -0,0 +1,104 @@
+#include "replaysession.h"
+#include <QHash>
+#include <algorithm>
+
+bool ReplaySession::load(const QString& path) {
+    clear();
+
+    GameRecordReader reader;
+    if (!reader.open(path.toStdString())) return false;
+
+    // Group rounds by match in file order. A round recorded twice (undo
+    // across a round end) keeps its last recording.
+    QHash<quint32, int> matchIndex;
+    reader.forEach([&](const RoundRecord& r) {
+        auto it = matchIndex.find(r.matchId);
+        if (it == matchIndex.end()) {
+            it = matchIndex.insert(r.matchId, m_matches.size());
+            m_matches.append(QVector<RoundRecord>());
+        }
+        QVector<RoundRecord>& rounds = m_matches[it.value()];
+        auto same = std::find_if(rounds.begin(), rounds.end(),
+                                 [&r](const RoundRecord& o) { return o.roundNumber == r.roundNumber; });
+        if (same != rounds.end()) {
+            *same = r;
+        } else {
+            rounds.append(r);
+        }
+    });
+
+    for (QVector<RoundRecord>& rounds : m_matches) {
+        std::sort(rounds.begin(), rounds.end(),
+                  [](const RoundRecord& a, const RoundRecord& b) { return a.roundNumber < b.roundNumber; });
+    }
+    return !m_matches.isEmpty();
+}
+
+void ReplaySession::clear() {
+    m_matches.clear();
+    m_rounds.clear();
+    m_currentMatch = -1;
+}
+
+bool ReplaySession::selectMatch(int match) {
+    if (match < 0 || match >= m_matches.size()) return false;
+
+    const QVector<RoundRecord>& records = m_matches[match];
+    QVector<Round> rounds;
+    rounds.reserve(records.size());
+
+    GameState state = initialState(records.first().gameRules());
+    for (const RoundRecord& record : records) {
+        // Each round is played under the rules it was recorded with
+        GameRules rules = record.gameRules();
+        state.rules = rules.flags();
+        state.endScore = static_cast<std::int16_t>(rules.endScore);
+        const RoundEngine& engine = roundEngine(state.rules);
+
+        Round round;
+        round.record = record;
+        round.engine = &engine;
+
+        state = dealRound(state, dealHands(record.dealId));
+
+        PassDirection dir = passDirectionForRound(record.roundNumber);
+        if (dir != PassDirection::None) {
+            Hands passed;
+            for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+                passed[i] = record.passed(i);
+                if (cardCount(passed[i]) != 3 || (passed[i] & ~state.hands[i])) return false;
+            }
+            state = applyPass(state, passed, dir);
+        }
+
+        for (int ply = 0; ply < CARD_COUNT; ++ply) {
+            if (ply % PLIES_PER_KEYFRAME == 0) {
+                round.keyframes[ply / PLIES_PER_KEYFRAME] = state;
+            }
+            int card = record.play(ply);
+            if (card >= CARD_COUNT || !(legalMoves(state) & cardBit(card))) return false;
+            state = engine.applyMove(state, card);
+            if (state.trickComplete()) state = collectTrick(state);
+        }
+
+        state = engine.scoreRound(state, nullptr);
+        round.scored = state;
+        rounds.append(round);
+    }
+
+    m_rounds = rounds;
+    m_currentMatch = match;
+    return true;
+}
+
+GameState ReplaySession::stateAt(int round, int ply) const {
+    const Round& r = m_rounds[round];
+    int k = std::min(ply / PLIES_PER_KEYFRAME, KEYFRAMES_PER_ROUND - 1);
+
+    GameState state = r.keyframes[k];
+    for (int i = k * PLIES_PER_KEYFRAME; i < ply; ++i) {
+        state = r.engine->applyMove(state, r.record.play(i));
+        if (state.trickComplete()) state = collectTrick(state);
+    }
+    return state;
+}
@@ -0,0 +1,116 @@
+#include "server/eventloop.h"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+static const int MAX_EVENTS = 256;
+static const std::uint64_t WAKE_TOKEN = ~0ull;
+
+EventLoop::EventLoop() {
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll >= 0 && m_wake >= 0) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = WAKE_TOKEN;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &ev);
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (m_wake >= 0) ::close(m_wake);
+    if (m_epoll >= 0) ::close(m_epoll);
+}
+
+bool EventLoop::add(int fd, std::uint32_t events, Handler handler) {
+    if (fd < 0) return false;
+    if (static_cast<std::size_t>(fd) >= m_watches.size()) {
+        m_watches.resize(fd + 1);
+    }
+
+    auto watch = std::make_unique<Watch>();
+    watch->token = (static_cast<std::uint64_t>(++m_generation) << 32) | static_cast<std::uint32_t>(fd);
+    watch->handler = std::move(handler);
+
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.u64 = watch->token;
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev) < 0) return false;
+
+    m_watches[fd] = std::move(watch);
+    return true;
+}
+
+void EventLoop::modify(int fd, std::uint32_t events) {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= m_watches.size() || !m_watches[fd]) return;
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.u64 = m_watches[fd]->token;
+    epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void EventLoop::remove(int fd) {
+    if (fd < 0 || static_cast<std::size_t>(fd) >= m_watches.size() || !m_watches[fd]) return;
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    // The handler may be the one running; free it after the dispatch batch
+    m_retired.push_back(std::move(m_watches[fd]));
+}
+
+void EventLoop::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_postMutex);
+        m_posted.push_back(std::move(task));
+    }
+    wake();
+}
+
+void EventLoop::stop() {
+    m_running = false;
+    wake();
+}
+
+void EventLoop::wake() {
+    std::uint64_t one = 1;
+    ssize_t ignored = ::write(m_wake, &one, sizeof(one));
+    (void)ignored;
+}
+
+void EventLoop::runPosted() {
+    std::uint64_t count;
+    while (::read(m_wake, &count, sizeof(count)) > 0) {}
+
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(m_postMutex);
+        tasks.swap(m_posted);
+    }
+    for (auto& task : tasks) task();
+}
+
+void EventLoop::run() {
+    m_running = true;
+    epoll_event events[MAX_EVENTS];
+
+    while (m_running) {
+        int n = epoll_wait(m_epoll, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            std::uint64_t token = events[i].data.u64;
+            if (token == WAKE_TOKEN) {
+                runPosted();
+                continue;
+            }
+            std::size_t fd = token & 0xffffffffu;
+            // Skip descriptors removed (or reused) earlier in this batch
+            if (fd >= m_watches.size() || !m_watches[fd] || m_watches[fd]->token != token) continue;
+            Watch* watch = m_watches[fd].get();
+            watch->handler(events[i].events);
+        }
+        m_retired.clear();
+    }
+}
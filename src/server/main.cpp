@@ -0,0 +1,54 @@
+#include "server/server.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+
+static void usage() {
+    std::fprintf(stderr,
+        "Usage: hearts-server [options]\n"
+        "  --socket PATH   Unix domain socket (default: hearts.sock)\n"
+        "  --port N        Also listen on 127.0.0.1:N\n"
+        "  --workers N     AI worker threads (default: one per core)\n"
+        "  --record FILE   Append finished rounds to a game-record stream\n");
+}
+
+int main(int argc, char* argv[]) {
+    Server::Options options;
+    options.socketPath = "hearts.sock";
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--socket") == 0 && value) {
+            options.socketPath = value;
+            ++i;
+        } else if (std::strcmp(arg, "--port") == 0 && value) {
+            options.tcpPort = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--workers") == 0 && value) {
+            options.workers = std::atoi(value);
+            ++i;
+        } else if (std::strcmp(arg, "--record") == 0 && value) {
+            options.recordPath = value;
+            ++i;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // Block before the worker threads start so only the signalfd sees these
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    Server server(options);
+    if (!server.listen() || !server.stopOnSignals(signals)) return 1;
+    server.run();
+    return 0;
+}
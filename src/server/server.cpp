@@ -0,0 +1,458 @@
+#include "server/server.h"
+#include "server/protocol.h"
+#include "rng.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static int workerCount(int requested) {
+    if (requested > 0) return requested;
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return cores > 0 ? cores : 2;
+}
+
+Server::Server(const Options& options)
+    : m_options(options)
+    , m_pool(workerCount(options.workers))
+{
+    std::random_device device;
+    m_seedCounter = (static_cast<std::uint64_t>(device()) << 32) ^ device() ^
+                    static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+Server::~Server() {
+    for (auto& entry : m_connections) ::close(entry.second->fd);
+    for (int fd : m_listeners) ::close(fd);
+    if (m_signalFd >= 0) ::close(m_signalFd);
+    if (!m_options.socketPath.empty()) ::unlink(m_options.socketPath.c_str());
+    m_records.close();
+}
+
+// ============================================================================
+// LISTENERS
+// ============================================================================
+
+bool Server::listen() {
+    if (!m_loop.isValid()) {
+        std::perror("hearts-server: epoll");
+        return false;
+    }
+
+    if (!m_options.socketPath.empty()) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (m_options.socketPath.size() >= sizeof(addr.sun_path)) {
+            std::fprintf(stderr, "hearts-server: socket path too long\n");
+            return false;
+        }
+        std::strcpy(addr.sun_path, m_options.socketPath.c_str());
+        ::unlink(addr.sun_path);  // Left behind by a previous run
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::perror("hearts-server: unix socket");
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        if (!listenOn(fd, "unix socket")) return false;
+        m_loop.add(fd, EPOLLIN, [this, fd](std::uint32_t) { acceptAll(fd, false); });
+    }
+
+    if (m_options.tcpPort > 0) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<std::uint16_t>(m_options.tcpPort));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        if (fd >= 0) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::perror("hearts-server: tcp socket");
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        if (!listenOn(fd, "tcp socket")) return false;
+        m_loop.add(fd, EPOLLIN, [this, fd](std::uint32_t) { acceptAll(fd, true); });
+    }
+
+    if (m_listeners.empty()) {
+        std::fprintf(stderr, "hearts-server: nothing to listen on\n");
+        return false;
+    }
+
+    if (!m_options.recordPath.empty() && !m_records.open(m_options.recordPath)) {
+        std::fprintf(stderr, "hearts-server: cannot open record file %s\n", m_options.recordPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Server::listenOn(int fd, const char* what) {
+    if (::listen(fd, SOMAXCONN) < 0) {
+        std::fprintf(stderr, "hearts-server: listen on %s: %s\n", what, std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+    m_listeners.push_back(fd);
+    return true;
+}
+
+bool Server::stopOnSignals(const sigset_t& signals) {
+    m_signalFd = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (m_signalFd < 0) return false;
+    return m_loop.add(m_signalFd, EPOLLIN, [this](std::uint32_t) { stop(); });
+}
+
+void Server::run() {
+    m_loop.run();
+    m_records.flush();
+}
+
+void Server::stop() {
+    m_loop.stop();
+}
+
+void Server::acceptAll(int listenFd, bool tcp) {
+    for (;;) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;  // EAGAIN, or out of descriptors until someone disconnects
+        }
+        if (tcp) {
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        int id = m_nextConnection++;
+        auto conn = std::make_unique<Connection>();
+        conn->id = id;
+        conn->fd = fd;
+        if (!m_loop.add(fd, EPOLLIN | EPOLLRDHUP, [this, id](std::uint32_t events) { onEvent(id, events); })) {
+            ::close(fd);
+            continue;
+        }
+
+        Connection& c = *conn;
+        m_connections.emplace(id, std::move(conn));
+        queue(c, "HELLO " + std::to_string(PROTOCOL_VERSION));
+        flush(c);
+    }
+}
+
+// ============================================================================
+// CONNECTIONS
+// ============================================================================
+
+Server::Connection* Server::connection(int id) {
+    auto it = m_connections.find(id);
+    return it == m_connections.end() ? nullptr : it->second.get();
+}
+
+void Server::onEvent(int id, std::uint32_t events) {
+    Connection* conn = connection(id);
+    if (!conn || conn->dead) return;
+
+    if (events & EPOLLOUT) flush(*conn);
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) readInput(*conn);
+}
+
+void Server::readInput(Connection& conn) {
+    char buffer[4096];
+    bool hangup = false;
+    for (;;) {
+        ssize_t n = ::recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn.input.append(buffer, static_cast<std::size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        hangup = true;  // EOF or error; still act on complete lines already read
+        break;
+    }
+
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t end = conn.input.find('\n', start);
+        if (end == std::string::npos) break;
+        handleLine(conn, conn.input.substr(start, end - start));
+        start = end + 1;
+        if (conn.dead || conn.closing) break;
+    }
+    conn.input.erase(0, start);
+
+    if (conn.input.size() > MAX_LINE) {
+        queue(conn, "ERR line too long");
+        conn.closing = true;
+    }
+    flush(conn);
+    if (hangup) drop(conn);
+}
+
+void Server::queue(Connection& conn, const std::string& line) {
+    if (conn.dead) return;
+    conn.output += line;
+    conn.output += '\n';
+}
+
+void Server::flush(Connection& conn) {
+    if (conn.dead) return;
+
+    std::size_t sent = 0;
+    while (sent < conn.output.size()) {
+        ssize_t n = ::send(conn.fd, conn.output.data() + sent, conn.output.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        drop(conn);
+        return;
+    }
+    conn.output.erase(0, sent);
+
+    if (conn.output.size() > MAX_OUTPUT) {
+        drop(conn);
+        return;
+    }
+    if (conn.output.empty() && conn.closing) {
+        drop(conn);
+        return;
+    }
+
+    bool wantWrite = !conn.output.empty();
+    if (wantWrite != conn.writeArmed) {
+        conn.writeArmed = wantWrite;
+        std::uint32_t events = EPOLLIN | EPOLLRDHUP;
+        if (wantWrite) events |= EPOLLOUT;
+        m_loop.modify(conn.fd, events);
+    }
+}
+
+void Server::drop(Connection& conn) {
+    if (conn.dead) return;
+    conn.dead = true;
+    // Callers may still hold `conn`; close it from the loop once they return
+    int id = conn.id;
+    m_loop.post([this, id]() { closeConnection(id); });
+}
+
+void Server::closeConnection(int id) {
+    Connection* conn = connection(id);
+    if (!conn) return;
+    leaveTable(*conn);
+    m_loop.remove(conn->fd);
+    ::close(conn->fd);
+    m_connections.erase(id);
+}
+
+// ============================================================================
+// COMMANDS
+// ============================================================================
+
+void Server::handleLine(Connection& conn, const std::string& line) {
+    std::vector<std::string> words = splitWords(line);
+    if (words.empty()) return;
+    const std::string& command = words[0];
+
+    if (command == "CREATE") {
+        createTable(conn, words);
+    } else if (command == "JOIN") {
+        joinTable(conn, words);
+    } else if (command == "LIST") {
+        listTables(conn);
+    } else if (command == "PASS" || command == "PLAY") {
+        if (!conn.table) {
+            queue(conn, "ERR not seated");
+            return;
+        }
+        std::size_t expected = command == "PASS" ? Table::CARDS_TO_PASS : 1;
+        CardSet cards = 0;
+        for (std::size_t i = 1; i < words.size(); ++i) {
+            int card = parseCardCode(words[i]);
+            if (card < 0) {
+                queue(conn, "ERR bad card " + words[i]);
+                return;
+            }
+            cards |= cardBit(card);
+        }
+        if (words.size() - 1 != expected || static_cast<std::size_t>(cardCount(cards)) != expected) {
+            queue(conn, "ERR expected " + std::to_string(expected) + " card(s)");
+            return;
+        }
+
+        std::shared_ptr<Table> table = conn.table;
+        Table::Messages out;
+        std::string error;
+        bool ok = command == "PASS" ? table->pass(conn.seat, cards, out, error)
+                                    : table->play(conn.seat, firstCard(cards), out, error);
+        if (!ok) {
+            queue(conn, "ERR " + error);
+            return;
+        }
+        if (command == "PASS") queue(conn, "OK");
+        afterTableChange(table, out);
+    } else if (command == "LEAVE") {
+        leaveTable(conn);
+        queue(conn, "OK");
+    } else if (command == "QUIT") {
+        conn.closing = true;
+    } else {
+        queue(conn, "ERR unknown command " + command);
+    }
+}
+
+void Server::createTable(Connection& conn, const std::vector<std::string>& args) {
+    if (conn.table) {
+        queue(conn, "ERR already seated");
+        return;
+    }
+
+    int humans = args.size() > 1 ? std::atoi(args[1].c_str()) : 0;
+    if (humans < 1 || humans > Table::NUM_SEATS) {
+        queue(conn, "ERR usage: CREATE <humans 1-4> [easy|medium|hard] [seed]");
+        return;
+    }
+
+    AIDifficulty difficulty = AIDifficulty::Medium;
+    if (args.size() > 2) {
+        if (args[2] == "easy") difficulty = AIDifficulty::Easy;
+        else if (args[2] == "medium") difficulty = AIDifficulty::Medium;
+        else if (args[2] == "hard") difficulty = AIDifficulty::Hard;
+        else {
+            queue(conn, "ERR unknown difficulty " + args[2]);
+            return;
+        }
+    }
+
+    std::uint64_t seed;
+    if (args.size() > 3) {
+        char* end = nullptr;
+        errno = 0;
+        seed = std::strtoull(args[3].c_str(), &end, 0);
+        if (errno != 0 || end == args[3].c_str() || *end != '\0') {
+            queue(conn, "ERR bad seed " + args[3]);
+            return;
+        }
+    } else {
+        seed = mixSeed(m_seedCounter++);
+    }
+
+    int id = m_nextTable++;
+    auto table = std::make_shared<Table>(id, humans, difficulty, seed, GameRules::standard());
+    m_tables.emplace(id, table);
+
+    Table::Messages out;
+    conn.seat = table->join(conn.id, out);
+    conn.table = table;
+    queue(conn, "SEAT " + std::to_string(id) + ' ' + std::to_string(conn.seat));
+    afterTableChange(table, out);
+}
+
+void Server::joinTable(Connection& conn, const std::vector<std::string>& args) {
+    if (conn.table) {
+        queue(conn, "ERR already seated");
+        return;
+    }
+
+    auto it = args.size() > 1 ? m_tables.find(std::atoi(args[1].c_str())) : m_tables.end();
+    if (it == m_tables.end()) {
+        queue(conn, "ERR no such table");
+        return;
+    }
+
+    std::shared_ptr<Table> table = it->second;
+    Table::Messages out;
+    int seat = table->join(conn.id, out);
+    if (seat < 0) {
+        queue(conn, "ERR table full");
+        return;
+    }
+    conn.seat = seat;
+    conn.table = table;
+    queue(conn, "SEAT " + std::to_string(table->id()) + ' ' + std::to_string(seat));
+    afterTableChange(table, out);
+}
+
+void Server::listTables(Connection& conn) {
+    std::string line = "TABLES";
+    for (const auto& entry : m_tables) {
+        int open = entry.second->openSeats();
+        if (open > 0) line += ' ' + std::to_string(entry.first) + ':' + std::to_string(open);
+    }
+    queue(conn, line);
+}
+
+void Server::leaveTable(Connection& conn) {
+    if (!conn.table) return;
+
+    std::shared_ptr<Table> table = conn.table;
+    table->leave(conn.seat);
+    conn.table.reset();
+    conn.seat = -1;
+
+    // Nobody left to play for; drop the table (a queued AI result is ignored)
+    if (table->humanCount() == 0) {
+        m_tables.erase(table->id());
+        return;
+    }
+    advance(table);
+}
+
+// ============================================================================
+// TABLES
+// ============================================================================
+
+void Server::afterTableChange(const std::shared_ptr<Table>& table, const Table::Messages& out) {
+    std::vector<int> touched;
+    for (const Table::Message& message : out) {
+        for (int seat = 0; seat < Table::NUM_SEATS; ++seat) {
+            if (message.seat >= 0 && message.seat != seat) continue;
+            int id = table->connection(seat);
+            if (id < 0) continue;
+            Connection* conn = connection(id);
+            if (!conn) continue;
+            queue(*conn, message.line);
+            touched.push_back(id);
+        }
+    }
+    for (int id : touched) {
+        if (Connection* conn = connection(id)) flush(*conn);
+    }
+
+    if (m_records.isOpen()) {
+        for (const RoundRecord& record : table->takeRecords()) m_records.append(record);
+    }
+
+    advance(table);
+}
+
+void Server::advance(const std::shared_ptr<Table>& table) {
+    Table::AiJob job;
+    if (!table->takeAiJob(job)) return;
+
+    m_pool.submit([this, table, job]() {
+        Table::AiResult result = table->runAi(job);
+        m_loop.post([this, table, result]() {
+            // The table may have closed while the worker was deciding
+            if (m_tables.find(table->id()) == m_tables.end()) return;
+            Table::Messages out;
+            table->finishAi(result, out);
+            afterTableChange(table, out);
+        });
+    });
+}
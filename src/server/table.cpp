@@ -0,0 +1,282 @@
+#include "server/table.h"
+#include "server/protocol.h"
+#include "aidecision.h"
+
+static std::string scoreWords(const GameState& s) {
+    std::string out;
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        out += ' ';
+        out += std::to_string(s.totalScores[i]);
+    }
+    return out;
+}
+
+Table::Table(int id, int humanSeats, AIDifficulty difficulty, std::uint64_t seed, const GameRules& rules)
+    : m_id(id)
+    , m_seed(seed)
+    , m_matchId(matchIdForSeed(seed))
+    , m_rules(rules)
+    , m_engine(&roundEngine(rules.flags()))
+    , m_core(initialState(rules))
+{
+    for (int i = 0; i < NUM_SEATS; ++i) {
+        m_connections[i] = i < humanSeats ? OPEN_SEAT : AI_SEAT;
+        m_players[i] = std::make_unique<Player>(i, QString(), false);
+        m_players[i]->setDifficulty(difficulty);
+    }
+}
+
+int Table::openSeats() const {
+    int n = 0;
+    for (int c : m_connections) {
+        if (c == OPEN_SEAT) n++;
+    }
+    return n;
+}
+
+int Table::humanCount() const {
+    int n = 0;
+    for (int c : m_connections) {
+        if (c >= 0) n++;
+    }
+    return n;
+}
+
+// ============================================================================
+// SEATS
+// ============================================================================
+
+int Table::join(int connection, Messages& out) {
+    if (m_phase != Phase::Waiting) return -1;
+
+    int seat = -1;
+    for (int i = 0; i < NUM_SEATS && seat < 0; ++i) {
+        if (m_connections[i] == OPEN_SEAT) seat = i;
+    }
+    if (seat < 0) return -1;
+    m_connections[seat] = connection;
+
+    if (openSeats() == 0) {
+        out.push_back({-1, "START " + std::to_string(m_seed)});
+        startRound(out);
+    }
+    return seat;
+}
+
+void Table::leave(int seat) {
+    if (m_connections[seat] < 0) return;
+    m_connections[seat] = m_phase == Phase::Waiting ? OPEN_SEAT : AI_SEAT;
+}
+
+// ============================================================================
+// ROUND FLOW
+// ============================================================================
+
+void Table::startRound(Messages& out) {
+    m_roundNumber++;
+    m_passDirection = passDirectionForRound(m_roundNumber);
+    m_dealId = dealIdForRound(m_seed, m_roundNumber);
+    m_core = dealRound(m_core, dealHands(m_dealId));
+
+    m_passes = {0, 0, 0, 0};
+    m_passChosen = {false, false, false, false};
+    m_playCount = 0;
+    for (auto& player : m_players) {
+        player->resetCardMemory();
+    }
+
+    std::string header = "DEAL " + std::to_string(m_roundNumber) + ' ' + passDirectionCode(m_passDirection) + ' ';
+    for (int seat = 0; seat < NUM_SEATS; ++seat) {
+        out.push_back({seat, header + cardCodes(m_core.hands[seat])});
+    }
+
+    if (m_passDirection == PassDirection::None) {
+        m_phase = Phase::Playing;
+        announceTurn(out);
+    } else {
+        m_phase = Phase::Passing;
+    }
+}
+
+bool Table::pass(int seat, CardSet cards, Messages& out, std::string& error) {
+    if (m_phase != Phase::Passing) {
+        error = "not passing";
+        return false;
+    }
+    if (m_passChosen[seat]) {
+        error = "already passed";
+        return false;
+    }
+    if (cardCount(cards) != CARDS_TO_PASS || (cards & ~m_core.hands[seat])) {
+        error = "pass three cards from your hand";
+        return false;
+    }
+
+    m_passes[seat] = cards;
+    m_passChosen[seat] = true;
+    executePass(out);
+    return true;
+}
+
+void Table::executePass(Messages& out) {
+    for (bool chosen : m_passChosen) {
+        if (!chosen) return;
+    }
+
+    m_core = applyPass(m_core, m_passes, m_passDirection);
+    for (int from = 0; from < NUM_SEATS; ++from) {
+        out.push_back({passTarget(from, m_passDirection), "RECEIVED " + cardCodes(m_passes[from])});
+    }
+
+    m_phase = Phase::Playing;
+    announceTurn(out);
+}
+
+bool Table::play(int seat, int card, Messages& out, std::string& error) {
+    if (m_phase != Phase::Playing) {
+        error = "not playing";
+        return false;
+    }
+    if (m_core.currentPlayer() != seat) {
+        error = "not your turn";
+        return false;
+    }
+    if (!(legalMoves(m_core) & cardBit(card))) {
+        error = "illegal card";
+        return false;
+    }
+
+    applyPlay(card, out);
+    return true;
+}
+
+void Table::applyPlay(int card, Messages& out) {
+    int player = m_core.currentPlayer();
+    m_core = m_engine->applyMove(m_core, card);
+    m_plays[m_playCount++] = static_cast<std::uint8_t>(card);
+
+    Card played = Card::fromIndex(card);
+    Suit leadSuit = static_cast<Suit>(m_core.leadSuit);
+    for (auto& p : m_players) {
+        p->cardMemory().recordCard(played, player, leadSuit);
+    }
+    out.push_back({-1, "PLAYED " + std::to_string(player) + ' ' + cardCode(card)});
+
+    if (m_core.trickComplete()) {
+        int winner = trickWinner(m_core);
+        int points = trickPoints(m_core);
+        m_core = collectTrick(m_core);
+        out.push_back({-1, "TRICK " + std::to_string(winner) + ' ' + std::to_string(points)});
+
+        if (m_core.roundComplete()) {
+            endRound(out);
+            return;
+        }
+    }
+    announceTurn(out);
+}
+
+void Table::announceTurn(Messages& out) {
+    int seat = m_core.currentPlayer();
+    out.push_back({-1, "TURN " + std::to_string(seat)});
+    if (!isAi(seat)) {
+        out.push_back({seat, "LEGAL " + cardCodes(legalMoves(m_core))});
+    }
+}
+
+void Table::endRound(Messages& out) {
+    int shooter = -1;
+    m_core = m_engine->scoreRound(m_core, &shooter);
+    m_records.push_back(RoundRecord::make(m_matchId, m_roundNumber, m_dealId, m_rules, m_passes, m_plays));
+    out.push_back({-1, "ROUND " + std::to_string(shooter) + scoreWords(m_core)});
+
+    if (matchOver(m_core)) {
+        m_phase = Phase::Over;
+        out.push_back({-1, "OVER " + std::to_string(matchWinner(m_core)) + scoreWords(m_core)});
+        return;
+    }
+    startRound(out);
+}
+
+std::vector<RoundRecord> Table::takeRecords() {
+    std::vector<RoundRecord> records;
+    records.swap(m_records);
+    return records;
+}
+
+// ============================================================================
+// AI SEATS
+// ============================================================================
+
+bool Table::takeAiJob(AiJob& job) {
+    if (m_aiBusy) return false;
+
+    job.seats = {false, false, false, false};
+    if (m_phase == Phase::Passing) {
+        bool any = false;
+        for (int i = 0; i < NUM_SEATS; ++i) {
+            job.seats[i] = isAi(i) && !m_passChosen[i];
+            any = any || job.seats[i];
+        }
+        if (!any) return false;
+        job.kind = AiJob::Pass;
+    } else if (m_phase == Phase::Playing) {
+        int seat = m_core.currentPlayer();
+        if (!isAi(seat)) return false;
+        job.seats[seat] = true;
+        job.kind = AiJob::Play;
+    } else {
+        return false;
+    }
+
+    job.state = m_core;
+    job.dealId = m_dealId;
+    job.roundNumber = m_roundNumber;
+    job.ply = m_playCount;
+    m_aiBusy = true;
+    return true;
+}
+
+Table::AiResult Table::runAi(const AiJob& job) {
+    AiResult result;
+    result.job = job;
+    result.passes = {0, 0, 0, 0};
+    result.card = -1;
+
+    for (int seat = 0; seat < NUM_SEATS; ++seat) {
+        if (!job.seats[seat]) continue;
+        Player& ai = *m_players[seat];
+        if (job.kind == AiJob::Pass) {
+            result.passes[seat] = aiPassDecision(ai, job.state, m_rules, job.roundNumber, job.dealId, seat);
+        } else {
+            result.card = aiPlayDecision(ai, job.state, m_rules, job.roundNumber, job.dealId, job.ply);
+        }
+    }
+    return result;
+}
+
+void Table::finishAi(const AiResult& result, Messages& out) {
+    m_aiBusy = false;
+
+    const AiJob& job = result.job;
+    if (job.roundNumber != m_roundNumber || job.ply != m_playCount) return;
+
+    if (job.kind == AiJob::Pass) {
+        if (m_phase != Phase::Passing) return;
+        for (int seat = 0; seat < NUM_SEATS; ++seat) {
+            if (!job.seats[seat] || m_passChosen[seat]) continue;
+            m_passes[seat] = result.passes[seat];
+            m_passChosen[seat] = true;
+        }
+        executePass(out);
+        return;
+    }
+
+    if (m_phase != Phase::Playing || !job.seats[m_core.currentPlayer()]) return;
+    CardSet legal = legalMoves(m_core);
+    int card = result.card;
+    if (card < 0 || !(legal & cardBit(card))) {
+        card = firstCard(legal);  // Never let a bad AI pick stall the table
+    }
+    applyPlay(card, out);
+}
@@ -0,0 +1,40 @@
+#include "server/workerpool.h"
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads < 1) threads = 1;
+    m_threads.reserve(threads);
+    for (int i = 0; i < threads; ++i) {
+        m_threads.emplace_back([this]() { work(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_ready.notify_all();
+    for (std::thread& t : m_threads) t.join();
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_ready.notify_one();
+}
+
+void WorkerPool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
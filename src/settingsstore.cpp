@@ -0,0 +1,82 @@
+#include "settingsstore.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+
+SettingsStore::SettingsStore(const QString& path)
+    : m_path(path)
+{
+    m_writer.setMaxThreadCount(1);
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(WRITE_DELAY);
+    QObject::connect(&m_debounce, &QTimer::timeout, [this]() { writeBehind(); });
+
+    QFile file(m_path);
+    if (file.open(QIODevice::ReadOnly)) {
+        m_values = QJsonDocument::fromJson(file.readAll()).object().toVariantMap();
+        return;
+    }
+
+    // First run with this store: carry over the QSettings of earlier versions
+    QSettings legacy("Hearts", "Hearts");
+    for (const QString& key : legacy.allKeys()) {
+        m_values.insert(key, legacy.value(key));
+    }
+    m_dirty = !m_values.isEmpty();
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+}
+
+SettingsStore::~SettingsStore() {
+    flush();
+}
+
+QString SettingsStore::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/settings.json";
+}
+
+QVariant SettingsStore::value(const QString& key, const QVariant& defaultValue) const {
+    return m_values.value(key, defaultValue);
+}
+
+void SettingsStore::setValue(const QString& key, const QVariant& value) {
+    auto it = m_values.find(key);
+    if (it != m_values.end() && it.value() == value) return;
+
+    m_values.insert(key, value);
+    m_dirty = true;
+    m_debounce.start();
+}
+
+void SettingsStore::remove(const QString& key) {
+    if (m_values.remove(key) == 0) return;
+    m_dirty = true;
+    m_debounce.start();
+}
+
+void SettingsStore::flush() {
+    m_debounce.stop();
+    writeBehind();
+    m_writer.waitForDone();
+}
+
+void SettingsStore::writeBehind() {
+    if (!m_dirty) return;
+    m_dirty = false;
+
+    // The map is implicitly shared: copying it here is cheap, and the worker
+    // serializes its own snapshot
+    QVariantMap values = m_values;
+    QString path = m_path;
+    m_writer.start([path, values]() {
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(QJsonDocument(QJsonObject::fromVariantMap(values)).toJson());
+            file.commit();
+        }
+    });
+}
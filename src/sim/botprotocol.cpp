@@ -0,0 +1,81 @@
+#include "sim/botprotocol.h"
+#include <cstdlib>
+
+static std::string cardList(CardSet cards) {
+    return cards ? cardCodes(cards, ',') : "-";
+}
+
+static std::string scoreList(const std::int16_t scores[GameState::NUM_PLAYERS]) {
+    std::string out;
+    for (int i = 0; i < GameState::NUM_PLAYERS; ++i) {
+        if (i) out += ',';
+        out += std::to_string(scores[i]);
+    }
+    return out;
+}
+
+std::string formatRequest(int id, bool pass, const BotPosition& p) {
+    const GameState& s = p.state;
+
+    std::string history;
+    for (int i = 0; i < p.playCount; ++i) {
+        if (i) history += ',';
+        history += std::to_string(p.playSeats[i]);
+        history += ':';
+        history += cardCode(p.plays[i]);
+    }
+
+    std::string line = "go " + std::to_string(id) + (pass ? " pass" : " play");
+    line += " seat " + std::to_string(p.seat);
+    line += " round " + std::to_string(p.roundNumber);
+    line += " dir ";
+    line += passDirectionCode(p.direction);
+    line += " rules " + std::to_string(s.rules);
+    line += " end " + std::to_string(s.endScore);
+    line += " totals " + scoreList(s.totalScores);
+    line += " points " + scoreList(s.roundScores);
+    line += " broken " + std::to_string(s.heartsBroken ? 1 : 0);
+    line += " hand " + cardList(s.hands[p.seat]);
+    line += " passed " + cardList(p.passed);
+    line += " received " + cardList(p.received);
+    line += " history " + (history.empty() ? std::string("-") : history);
+    line += " legal " + cardList(pass ? s.hands[p.seat] : legalMoves(s));
+    return line;
+}
+
+BotReply parseReply(const std::string& line) {
+    BotReply reply;
+    std::vector<std::string> words = splitWords(line);
+    if (words.empty()) return reply;
+
+    const std::string& kind = words[0];
+    if (kind == "ready") {
+        reply.kind = BotReply::Ready;
+        for (std::size_t i = 1; i < words.size(); ++i) {
+            if (i > 1) reply.name += ' ';
+            reply.name += words[i];
+        }
+        return reply;
+    }
+    if (kind != "pass" && kind != "play") return reply;
+
+    std::size_t expected = kind == "pass" ? 3 : 1;
+    reply.kind = BotReply::Malformed;
+    if (words.size() < 2) return reply;
+
+    char* end = nullptr;
+    long id = std::strtol(words[1].c_str(), &end, 10);
+    if (end == words[1].c_str() || *end != '\0' || id < 0) return reply;
+    reply.id = static_cast<int>(id);
+
+    if (words.size() != expected + 2) return reply;
+    for (std::size_t i = 2; i < words.size(); ++i) {
+        int card = parseCardCode(words[i]);
+        if (card < 0) return reply;
+        reply.cards |= cardBit(card);
+    }
+    if (static_cast<std::size_t>(cardCount(reply.cards)) != expected) return reply;
+
+    reply.kind = kind == "pass" ? BotReply::Pass : BotReply::Play;
+    return reply;
+}
@@ -0,0 +1,144 @@
+#include "sim/engineprocess.h"
+#include "sim/botprotocol.h"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+EngineProcess::EngineProcess(const std::string& command)
+    : m_command(command)
+    , m_name(command)
+{
+}
+
+EngineProcess::~EngineProcess() {
+    if (m_in >= 0) {
+        send("quit");
+        flush();
+    }
+    shutdown();
+    if (m_pid > 0) {
+        // Give it a moment to exit on its own before insisting
+        for (int i = 0; i < 50; ++i) {
+            if (waitpid(m_pid, nullptr, WNOHANG) == m_pid) return;
+            usleep(10000);
+        }
+        kill(m_pid, SIGKILL);
+        waitpid(m_pid, nullptr, 0);
+    }
+}
+
+void EngineProcess::shutdown() {
+    if (m_in >= 0) ::close(m_in);
+    if (m_out >= 0) ::close(m_out);
+    m_in = -1;
+    m_out = -1;
+}
+
+bool EngineProcess::start(int timeoutMs) {
+    int toEngine[2];
+    int fromEngine[2];
+    if (pipe2(toEngine, O_CLOEXEC) < 0) return false;
+    if (pipe2(fromEngine, O_CLOEXEC) < 0) {
+        ::close(toEngine[0]);
+        ::close(toEngine[1]);
+        return false;
+    }
+
+    m_pid = fork();
+    if (m_pid == 0) {
+        dup2(toEngine[0], STDIN_FILENO);
+        dup2(fromEngine[1], STDOUT_FILENO);
+        execl("/bin/sh", "sh", "-c", m_command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    ::close(toEngine[0]);
+    ::close(fromEngine[1]);
+    if (m_pid < 0) {
+        ::close(toEngine[1]);
+        ::close(fromEngine[0]);
+        return false;
+    }
+
+    m_in = toEngine[1];
+    m_out = fromEngine[0];
+    fcntl(m_in, F_SETFL, O_NONBLOCK);
+    fcntl(m_out, F_SETFL, O_NONBLOCK);
+
+    send("hearts " + std::to_string(BOT_PROTOCOL_VERSION));
+    flush();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::vector<std::string> lines;
+    for (;;) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) return false;
+
+        pollfd pfd = {m_out, POLLIN, 0};
+        poll(&pfd, 1, static_cast<int>(left.count()));
+        if (!readLines(lines)) return false;
+        for (const std::string& line : lines) {
+            BotReply reply = parseReply(line);
+            if (reply.kind == BotReply::Ready) {
+                if (!reply.name.empty()) m_name = reply.name;
+                return true;
+            }
+        }
+        lines.clear();
+    }
+}
+
+void EngineProcess::send(const std::string& line) {
+    if (m_in < 0) return;
+    m_pending += line;
+    m_pending += '\n';
+}
+
+void EngineProcess::flush() {
+    std::size_t written = 0;
+    while (m_in >= 0 && written < m_pending.size()) {
+        ssize_t n = ::write(m_in, m_pending.data() + written, m_pending.size() - written);
+        if (n > 0) {
+            written += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && errno == EAGAIN) {
+            break;
+        } else {
+            shutdown();  // EPIPE: the engine is gone
+            m_pending.clear();
+            return;
+        }
+    }
+    m_pending.erase(0, written);
+}
+
+bool EngineProcess::readLines(std::vector<std::string>& lines) {
+    if (m_out < 0) return false;
+
+    char buffer[8192];
+    for (;;) {
+        ssize_t n = ::read(m_out, buffer, sizeof(buffer));
+        if (n > 0) {
+            m_input.append(buffer, static_cast<std::size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) break;
+        shutdown();
+        break;
+    }
+
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t end = m_input.find('\n', start);
+        if (end == std::string::npos) break;
+        lines.push_back(m_input.substr(start, end - start));
+        start = end + 1;
+    }
+    m_input.erase(0, start);
+    return m_out >= 0;
+}
@@ -0,0 +1,73 @@
+#include "sim/simulator.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void usage() {
+    std::fprintf(stderr,
+        "Usage: hearts-sim [options]\n"
+        "  --seat N SPEC    Seat N (0-3): easy, medium, hard or engine:COMMAND (default: medium)\n"
+        "  --matches N      Matches to play (default: 100)\n"
+        "  --parallel N     Matches in flight, for pipelining engine requests (default: 32)\n"
+        "  --seed N         Base seed; match k uses a seed derived from it (default: 1)\n"
+        "  --movetime MS    Per-move time limit for engines (default: 1000)\n"
+        "  --rotate         Move every player one seat along each match\n"
+        "  --end-score N    Score that ends a match (default: 100)\n"
+        "  --rules BITS     RuleFlag bits (default: 1, Queen of Spades breaks hearts)\n"
+        "  --record FILE    Append every round to a game-record stream\n");
+}
+
+static bool parseNumber(const char* text, unsigned long long& value) {
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 0);
+    return end != text && *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+    Simulator::Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        unsigned long long n = 0;
+        auto number = [&](unsigned long long& out) {
+            return i + 1 < argc && parseNumber(argv[++i], out);
+        };
+
+        if (std::strcmp(arg, "--seat") == 0 && i + 2 < argc && parseNumber(argv[i + 1], n) && n < 4) {
+            options.seats[n] = argv[i + 2];
+            i += 2;
+        } else if (std::strcmp(arg, "--matches") == 0 && number(n)) {
+            options.matches = static_cast<int>(n);
+        } else if (std::strcmp(arg, "--parallel") == 0 && number(n) && n > 0) {
+            options.parallel = static_cast<int>(n);
+        } else if (std::strcmp(arg, "--seed") == 0 && number(n)) {
+            options.seed = n;
+        } else if (std::strcmp(arg, "--movetime") == 0 && number(n)) {
+            options.moveTimeMs = static_cast<int>(n);
+        } else if (std::strcmp(arg, "--rotate") == 0) {
+            options.rotate = true;
+        } else if (std::strcmp(arg, "--end-score") == 0 && number(n) && n > 0) {
+            options.rules.endScore = static_cast<int>(n);
+        } else if (std::strcmp(arg, "--rules") == 0 && number(n) && n < 16) {
+            options.rules.queenBreaksHearts = n & RuleQueenBreaksHearts;
+            options.rules.moonProtection = n & RuleMoonProtection;
+            options.rules.fullPolish = n & RuleFullPolish;
+            options.rules.exactResetTo50 = n & RuleExactResetTo50;
+        } else if (std::strcmp(arg, "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // A crashed engine must not take the simulator down with it
+    std::signal(SIGPIPE, SIG_IGN);
+
+    Simulator sim(options);
+    if (!sim.setup()) return 1;
+    sim.run();
+    sim.report(stdout);
+    return 0;
+}
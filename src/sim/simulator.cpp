@@ -0,0 +1,374 @@
+#include "sim/simulator.h"
+#include "aidecision.h"
+#include "rng.h"
+#include <algorithm>
+#include <poll.h>
+
+Simulator::Simulator(const Options& options)
+    : m_options(options)
+    , m_engine(&roundEngine(options.rules.flags()))
+{
+}
+
+Simulator::~Simulator() {
+    m_records.close();
+}
+
+bool Simulator::setup() {
+    for (const std::string& spec : m_options.seats) {
+        Participant p;
+        p.spec = spec;
+        if (spec == "easy") {
+            p.difficulty = AIDifficulty::Easy;
+        } else if (spec == "medium") {
+            p.difficulty = AIDifficulty::Medium;
+        } else if (spec == "hard") {
+            p.difficulty = AIDifficulty::Hard;
+        } else if (spec.compare(0, 7, "engine:") == 0 && spec.size() > 7) {
+            std::string command = spec.substr(7);
+            // Seats running the same command share one process
+            for (std::size_t i = 0; i < m_engines.size(); ++i) {
+                if (m_engines[i]->command() == command) p.engine = static_cast<int>(i);
+            }
+            if (p.engine < 0) {
+                auto engine = std::make_unique<EngineProcess>(command);
+                if (!engine->start(5000)) {
+                    std::fprintf(stderr, "hearts-sim: engine did not become ready: %s\n", command.c_str());
+                    return false;
+                }
+                p.engine = static_cast<int>(m_engines.size());
+                m_engines.push_back(std::move(engine));
+                m_engineQueue.push_back(0);
+            }
+        } else {
+            std::fprintf(stderr, "hearts-sim: unknown seat '%s' (easy, medium, hard or engine:COMMAND)\n", spec.c_str());
+            return false;
+        }
+        m_participants.push_back(p);
+    }
+
+    if (!m_options.recordPath.empty() && !m_records.open(m_options.recordPath)) {
+        std::fprintf(stderr, "hearts-sim: cannot open record file %s\n", m_options.recordPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// DRIVER
+// ============================================================================
+
+void Simulator::run() {
+    m_started = Clock::now();
+
+    while (m_finished < m_options.matches) {
+        // Top up the matches in flight
+        bool started = false;
+        while (static_cast<int>(m_active.size()) < m_options.parallel && m_nextMatch < m_options.matches) {
+            auto match = std::make_unique<Match>();
+            startMatch(*match, m_nextMatch++);
+            m_active.push_back(std::move(match));
+            started = true;
+        }
+
+        for (auto& match : m_active) advance(*match);
+
+        m_active.erase(std::remove_if(m_active.begin(), m_active.end(),
+                                      [](const std::unique_ptr<Match>& m) { return m->over; }),
+                       m_active.end());
+
+        // Wait for engines only when no match can move without them
+        pumpEngines(!started);
+    }
+
+    m_records.flush();
+    m_elapsedSeconds = std::chrono::duration<double>(Clock::now() - m_started).count();
+}
+
+void Simulator::startMatch(Match& match, int index) {
+    match.index = index;
+    match.seed = deriveSeed(m_options.seed, static_cast<std::uint64_t>(index));
+    match.matchId = matchIdForSeed(match.seed);
+    for (int seat = 0; seat < NUM_SEATS; ++seat) {
+        int p = m_options.rotate ? (seat + index) % NUM_SEATS : seat;
+        match.participant[seat] = p;
+        match.players[seat] = std::make_unique<Player>(seat, QString(), false);
+        match.players[seat]->setDifficulty(m_participants[p].difficulty);
+    }
+    match.core = initialState(m_options.rules);
+    startRound(match);
+}
+
+void Simulator::startRound(Match& match) {
+    match.roundNumber++;
+    match.direction = passDirectionForRound(match.roundNumber);
+    match.dealId = dealIdForRound(match.seed, match.roundNumber);
+    match.core = dealRound(match.core, dealHands(match.dealId));
+
+    match.passes = {0, 0, 0, 0};
+    match.passChosen = {false, false, false, false};
+    match.playCount = 0;
+    match.passing = match.direction != PassDirection::None;
+    for (auto& player : match.players) {
+        player->resetCardMemory();
+    }
+}
+
+void Simulator::advance(Match& match) {
+    while (!match.over) {
+        if (match.passing) {
+            bool allChosen = true;
+            for (int seat = 0; seat < NUM_SEATS; ++seat) {
+                if (match.passChosen[seat]) continue;
+                if (!match.waiting[seat]) {
+                    if (m_participants[match.participant[seat]].engine >= 0) {
+                        request(match, seat, true);
+                    } else {
+                        match.passes[seat] = aiPassDecision(*match.players[seat], match.core, m_options.rules,
+                                                            match.roundNumber, match.dealId, seat);
+                        match.passChosen[seat] = true;
+                    }
+                }
+                allChosen = allChosen && match.passChosen[seat];
+            }
+            if (!allChosen) return;
+            applyPass(match);
+            continue;
+        }
+
+        int seat = match.core.currentPlayer();
+        if (match.waiting[seat]) return;
+        if (m_participants[match.participant[seat]].engine >= 0) {
+            request(match, seat, false);
+            continue;  // A dead engine answers on the spot
+        }
+
+        CardSet legal = legalMoves(match.core);
+        int card = aiPlayDecision(*match.players[seat], match.core, m_options.rules,
+                                  match.roundNumber, match.dealId, match.playCount);
+        if (!(legal & cardBit(card))) card = firstCard(legal);
+        applyPlay(match, card);
+    }
+}
+
+void Simulator::applyPass(Match& match) {
+    match.core = ::applyPass(match.core, match.passes, match.direction);
+    match.passing = false;
+}
+
+void Simulator::applyPlay(Match& match, int card) {
+    int seat = match.core.currentPlayer();
+    match.core = m_engine->applyMove(match.core, card);
+    match.plays[match.playCount] = static_cast<std::uint8_t>(card);
+    match.playSeats[match.playCount] = static_cast<std::uint8_t>(seat);
+    match.playCount++;
+
+    Card played = Card::fromIndex(card);
+    Suit leadSuit = static_cast<Suit>(match.core.leadSuit);
+    for (auto& player : match.players) {
+        player->cardMemory().recordCard(played, seat, leadSuit);
+    }
+
+    if (match.core.trickComplete()) {
+        match.core = collectTrick(match.core);
+        if (match.core.roundComplete()) endRound(match);
+    }
+}
+
+void Simulator::endRound(Match& match) {
+    int shooter = -1;
+    match.core = m_engine->scoreRound(match.core, &shooter);
+    if (shooter >= 0) m_participants[match.participant[shooter]].moons++;
+
+    if (m_records.isOpen()) {
+        m_records.append(RoundRecord::make(match.matchId, match.roundNumber, match.dealId,
+                                           m_options.rules, match.passes, match.plays));
+    }
+
+    if (matchOver(match.core)) {
+        finishMatch(match);
+    } else {
+        startRound(match);
+    }
+}
+
+void Simulator::finishMatch(Match& match) {
+    match.over = true;
+    m_finished++;
+
+    int winner = matchWinner(match.core);
+    for (int seat = 0; seat < NUM_SEATS; ++seat) {
+        Participant& p = m_participants[match.participant[seat]];
+        p.matches++;
+        p.scoreSum += match.core.totalScores[seat];
+        if (seat == winner) p.wins++;
+    }
+}
+
+// ============================================================================
+// ENGINES
+// ============================================================================
+
+void Simulator::request(Match& match, int seat, bool pass) {
+    Participant& p = m_participants[match.participant[seat]];
+    EngineProcess& engine = *m_engines[p.engine];
+
+    int id = m_nextRequest++;
+    Clock::time_point now = Clock::now();
+    int queued = ++m_engineQueue[p.engine];
+    Clock::time_point deadline = now + std::chrono::milliseconds(m_options.moveTimeMs) * queued;
+
+    m_requests[id] = Request{&match, seat, pass, match.roundNumber, match.playCount, now, deadline};
+    match.waiting[seat] = true;
+    p.requests++;
+
+    if (!engine.isAlive()) {
+        answer(id, nullptr);
+        return;
+    }
+
+    BotPosition position;
+    position.state = match.core;
+    position.seat = seat;
+    position.roundNumber = match.roundNumber;
+    position.direction = match.direction;
+    position.passed = 0;
+    position.received = 0;
+    if (!pass && match.direction != PassDirection::None) {
+        position.passed = match.passes[seat];
+        for (int from = 0; from < NUM_SEATS; ++from) {
+            if (passTarget(from, match.direction) == seat) position.received = match.passes[from];
+        }
+    }
+    position.plays = match.plays;
+    position.playSeats = match.playSeats;
+    position.playCount = match.playCount;
+    engine.send(formatRequest(id, pass, position));
+}
+
+void Simulator::answer(int id, const BotReply* reply) {
+    auto it = m_requests.find(id);
+    if (it == m_requests.end()) return;  // Already timed out
+    Request r = it->second;
+    m_requests.erase(it);
+
+    Match& match = *r.match;
+    Participant& p = m_participants[match.participant[r.seat]];
+    match.waiting[r.seat] = false;
+    m_engineQueue[p.engine]--;
+
+    if (reply) {
+        p.latencySumMs += std::chrono::duration<double, std::milli>(Clock::now() - r.sent).count();
+    } else {
+        p.timeouts++;
+    }
+
+    // Forfeited or illegal moves fall back to the lowest cards
+    if (r.pass) {
+        CardSet hand = match.core.hands[r.seat];
+        CardSet cards = 0;
+        if (reply && reply->kind == BotReply::Pass && !(reply->cards & ~hand)) {
+            cards = reply->cards;
+        } else {
+            if (reply) p.illegal++;
+            for (int i = 0; i < 3; ++i) cards |= cardBit(firstCard(hand & ~cards));
+        }
+        match.passes[r.seat] = cards;
+        match.passChosen[r.seat] = true;
+        return;
+    }
+
+    CardSet legal = legalMoves(match.core);
+    int card;
+    if (reply && reply->kind == BotReply::Play && (reply->cards & legal)) {
+        card = firstCard(reply->cards);
+    } else {
+        if (reply) p.illegal++;
+        card = firstCard(legal);
+    }
+    applyPlay(match, card);
+}
+
+void Simulator::pumpEngines(bool block) {
+    std::vector<pollfd> fds;
+    std::vector<int> owners;
+    for (std::size_t i = 0; i < m_engines.size(); ++i) {
+        EngineProcess& engine = *m_engines[i];
+        engine.flush();
+        if (!engine.isAlive()) continue;
+        fds.push_back({engine.readFd(), POLLIN, 0});
+        owners.push_back(static_cast<int>(i));
+        if (engine.wantsWrite()) {
+            fds.push_back({engine.writeFd(), POLLOUT, 0});
+            owners.push_back(static_cast<int>(i));
+        }
+    }
+
+    int timeout = 0;
+    if (block && !m_requests.empty()) {
+        Clock::time_point next = Clock::time_point::max();
+        for (const auto& entry : m_requests) next = std::min(next, entry.second.deadline);
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next - Clock::now()).count();
+        timeout = static_cast<int>(std::max<long long>(0, wait + 1));
+    }
+    if (!fds.empty() || timeout > 0) {
+        poll(fds.data(), fds.size(), timeout);
+    }
+
+    std::vector<std::string> lines;
+    for (std::size_t i = 0; i < m_engines.size(); ++i) {
+        EngineProcess& engine = *m_engines[i];
+        lines.clear();
+        bool alive = engine.readLines(lines);
+        for (const std::string& line : lines) {
+            BotReply reply = parseReply(line);
+            if (reply.id >= 0) answer(reply.id, &reply);
+        }
+        if (!alive) {
+            // Everything still outstanding with this engine is forfeited
+            std::vector<int> orphaned;
+            for (const auto& entry : m_requests) {
+                if (m_participants[entry.second.match->participant[entry.second.seat]].engine == static_cast<int>(i)) {
+                    orphaned.push_back(entry.first);
+                }
+            }
+            for (int id : orphaned) answer(id, nullptr);
+        }
+    }
+
+    Clock::time_point now = Clock::now();
+    std::vector<int> expired;
+    for (const auto& entry : m_requests) {
+        if (entry.second.deadline <= now) expired.push_back(entry.first);
+    }
+    for (int id : expired) answer(id, nullptr);
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+void Simulator::report(std::FILE* out) const {
+    std::fprintf(out, "%d matches in %.2f s (%.1f matches/s)\n\n", m_finished, m_elapsedSeconds,
+                 m_elapsedSeconds > 0 ? m_finished / m_elapsedSeconds : 0.0);
+    std::fprintf(out, "%-4s %-32s %8s %6s %7s %10s %6s\n", "seat", "player", "matches", "wins", "win%", "avg score", "moons");
+    for (std::size_t i = 0; i < m_participants.size(); ++i) {
+        const Participant& p = m_participants[i];
+        std::string name = p.engine >= 0 ? m_engines[p.engine]->name() : p.spec;
+        std::fprintf(out, "%-4zu %-32.32s %8d %6d %6.1f%% %10.2f %6d\n", i, name.c_str(), p.matches, p.wins,
+                     p.matches ? 100.0 * p.wins / p.matches : 0.0,
+                     p.matches ? static_cast<double>(p.scoreSum) / p.matches : 0.0, p.moons);
+    }
+
+    bool header = false;
+    for (std::size_t i = 0; i < m_participants.size(); ++i) {
+        const Participant& p = m_participants[i];
+        if (p.engine < 0) continue;
+        if (!header) {
+            std::fprintf(out, "\n%-4s %10s %9s %8s %12s\n", "seat", "requests", "timeouts", "illegal", "avg reply");
+            header = true;
+        }
+        std::fprintf(out, "%-4zu %10d %9d %8d %9.3f ms\n", i, p.requests, p.timeouts, p.illegal,
+                     p.requests > p.timeouts ? p.latencySumMs / (p.requests - p.timeouts) : 0.0);
+    }
+}
@@ -0,0 +1,223 @@
+#include "statslog.h"
+#include "gamerecord.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cstring>
+
+static const quint32 LOG_MAGIC = 0x54534851;       // "QHST"
+static const quint32 SNAPSHOT_MAGIC = 0x41534851;  // "QHSA"
+static const quint16 LOG_VERSION = 1;
+static const quint16 SNAPSHOT_VERSION = 2;
+static const qint64 LOG_HEADER_SIZE = 16;
+
+struct LogHeader {
+    quint32 magic;
+    quint16 version;
+    quint16 recordSize;
+    quint32 reserved[2];
+};
+
+static_assert(sizeof(LogHeader) == LOG_HEADER_SIZE, "Header keeps records aligned");
+
+static quint32 checksumOf(MatchStatsRecord record) {
+    record.crc = 0;
+    return recordChecksum(&record, sizeof(record));
+}
+
+// ============================================================================
+// AGGREGATES
+// ============================================================================
+
+void StatsAggregate::add(const MatchStatsRecord& record) {
+    if (record.kind == MatchStatsRecord::Import) {
+        imports++;
+        games += static_cast<quint32>(record.seed);
+        wins += static_cast<quint32>(record.seed >> 32);
+        totalScore += record.finishedAt;
+        bestScore = std::min<qint32>(bestScore, record.endScore);
+        moons += record.matchId;
+        return;
+    }
+
+    int score = record.finalScores[0];
+    bool won = record.winner == 0;
+
+    games++;
+    if (won) wins++;
+    for (std::uint8_t shots : record.moonShots) moons += shots;
+    totalScore += score;
+    bestScore = std::min<qint32>(bestScore, score);
+    totalDurationSecs += record.durationSecs;
+
+    if (record.difficulty < DIFFICULTIES) {
+        gamesByDifficulty[record.difficulty]++;
+        if (won) winsByDifficulty[record.difficulty]++;
+    }
+
+    int bin = std::clamp(score - SCORE_MIN, 0, SCORE_BINS - 1);
+    scoreHistogram[bin]++;
+}
+
+double StatsAggregate::winRate(int difficulty) const {
+    if (difficulty < 0 || difficulty >= DIFFICULTIES || gamesByDifficulty[difficulty] == 0) return -1;
+    return 100.0 * winsByDifficulty[difficulty] / gamesByDifficulty[difficulty];
+}
+
+int StatsAggregate::scorePercentile(double p) const {
+    quint64 counted = 0;
+    for (quint32 n : scoreHistogram) counted += n;
+    if (counted == 0) return 0;
+
+    // Rank of the wanted game, 1-based
+    quint64 rank = static_cast<quint64>(std::clamp(p, 0.0, 1.0) * counted + 0.5);
+    rank = std::max<quint64>(rank, 1);
+
+    quint64 seen = 0;
+    for (int bin = 0; bin < SCORE_BINS; ++bin) {
+        seen += scoreHistogram[bin];
+        if (seen >= rank) return bin + SCORE_MIN;
+    }
+    return SCORE_BINS - 1 + SCORE_MIN;
+}
+
+// ============================================================================
+// LOG
+// ============================================================================
+
+StatsLog::StatsLog(const QString& dir)
+    : m_logPath(dir + "/stats.log")
+    , m_snapshotPath(dir + "/stats.agg")
+{
+    QDir().mkpath(dir);
+    if (!loadSnapshot()) m_aggregate = StatsAggregate();
+    catchUp();
+}
+
+QString StatsLog::defaultDir() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+}
+
+void StatsLog::append(MatchStatsRecord record) {
+    QFile file(m_logPath);
+    if (!file.open(QIODevice::ReadWrite)) return;
+
+    if (file.size() < LOG_HEADER_SIZE) {
+        LogHeader header = {LOG_MAGIC, LOG_VERSION, static_cast<quint16>(sizeof(MatchStatsRecord)), {0, 0}};
+        file.resize(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    record.reserved = 0;
+    record.crc = checksumOf(record);
+    file.seek(LOG_HEADER_SIZE + static_cast<qint64>(m_aggregate.records) * sizeof(MatchStatsRecord));
+    if (file.write(reinterpret_cast<const char*>(&record), sizeof(record)) != sizeof(record)) return;
+    file.flush();
+
+    m_aggregate.add(record);
+    m_aggregate.records++;
+    saveSnapshot();
+}
+
+void StatsLog::importTotals(int games, int wins, int totalScore, int bestScore, int moons) {
+    if (hasImported()) return;
+
+    MatchStatsRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.kind = MatchStatsRecord::Import;
+    record.seed = static_cast<quint32>(games) | static_cast<std::uint64_t>(static_cast<quint32>(wins)) << 32;
+    record.finishedAt = totalScore;
+    record.matchId = static_cast<quint32>(moons);
+    record.endScore = static_cast<qint16>(std::clamp(bestScore, -32768, 32767));
+    append(record);
+}
+
+void StatsLog::reset() {
+    QFile::remove(m_logPath);
+    m_aggregate = StatsAggregate();
+    saveSnapshot();
+}
+
+// Folds log records the snapshot hasn't seen and cuts off a torn or
+// corrupt tail
+void StatsLog::catchUp() {
+    QFile file(m_logPath);
+    if (!file.open(QIODevice::ReadWrite)) return;
+
+    LogHeader header;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+        header.magic != LOG_MAGIC || header.version != LOG_VERSION ||
+        header.recordSize != sizeof(MatchStatsRecord)) {
+        // Unknown or empty log: start a new one
+        file.resize(0);
+        if (m_aggregate.records) {
+            m_aggregate = StatsAggregate();
+            saveSnapshot();
+        }
+        return;
+    }
+
+    quint64 count = static_cast<quint64>(file.size() - LOG_HEADER_SIZE) / sizeof(MatchStatsRecord);
+    bool rebuilt = m_aggregate.records > count;
+    if (rebuilt) {
+        // The log lost records the snapshot counted; rebuild from scratch
+        m_aggregate = StatsAggregate();
+    }
+
+    quint64 start = m_aggregate.records;
+    quint64 folded = start;
+    file.seek(LOG_HEADER_SIZE + static_cast<qint64>(folded) * sizeof(MatchStatsRecord));
+    MatchStatsRecord record;
+    while (folded < count) {
+        if (file.read(reinterpret_cast<char*>(&record), sizeof(record)) != sizeof(record) ||
+            record.crc != checksumOf(record)) {
+            break;
+        }
+        m_aggregate.add(record);
+        m_aggregate.records = ++folded;
+    }
+
+    qint64 validSize = LOG_HEADER_SIZE + static_cast<qint64>(folded) * sizeof(MatchStatsRecord);
+    if (file.size() != validSize) file.resize(validSize);
+    if (rebuilt || folded != start) saveSnapshot();
+}
+
+bool StatsLog::loadSnapshot() {
+    QFile file(m_snapshotPath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic;
+    quint16 version;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION) return false;
+
+    StatsAggregate a;
+    in >> a.records >> a.imports >> a.games >> a.wins >> a.moons;
+    in >> a.totalScore >> a.bestScore >> a.totalDurationSecs;
+    for (int i = 0; i < StatsAggregate::DIFFICULTIES; ++i) in >> a.gamesByDifficulty[i] >> a.winsByDifficulty[i];
+    for (quint32& n : a.scoreHistogram) in >> n;
+    if (in.status() != QDataStream::Ok) return false;
+
+    m_aggregate = a;
+    return true;
+}
+
+void StatsLog::saveSnapshot() const {
+    const StatsAggregate& a = m_aggregate;
+    QSaveFile file(m_snapshotPath);
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+    out << a.records << a.imports << a.games << a.wins << a.moons;
+    out << a.totalScore << a.bestScore << a.totalDurationSecs;
+    for (int i = 0; i < StatsAggregate::DIFFICULTIES; ++i) out << a.gamesByDifficulty[i] << a.winsByDifficulty[i];
+    for (quint32 n : a.scoreHistogram) out << n;
+    file.commit();
+}
@@ -0,0 +1,115 @@
+#include "trickmodel.h"
+#include "card.h"
+#include <QRandomGenerator>
+
+TrickModel::TrickModel(GameClock* clock, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_clock(clock)
+{
+}
+
+int TrickModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant TrickModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_rows.size()) return QVariant();
+
+    const Row& row = m_rows[index.row()];
+    switch (role) {
+        case PlayerRole:         return row.player;
+        case SuitRole:           return cardSuit(row.card);
+        case RankRole:           return cardRankIndex(row.card) + 2;
+        case ElementIdRole:      return cardElementId(row.card);
+        case RotationRole:       return row.rotation;
+        case AnimationPhaseRole: return row.phase;
+        case WinnerRole:         return row.winner;
+        default:                 return QVariant();
+    }
+}
+
+QHash<int, QByteArray> TrickModel::roleNames() const {
+    return {
+        {PlayerRole, "player"},
+        {SuitRole, "suit"},
+        {RankRole, "rank"},
+        {ElementIdRole, "elementId"},
+        {RotationRole, "cardRotation"},
+        {AnimationPhaseRole, "animationPhase"},
+        {WinnerRole, "winner"}
+    };
+}
+
+void TrickModel::play(int player, int card) {
+    append(player, card, Entering);
+}
+
+void TrickModel::collect(int winner) {
+    int count = m_rows.size() - m_exiting;
+    if (count == 0) return;
+
+    for (int i = m_exiting; i < m_rows.size(); ++i) {
+        m_rows[i].phase = Exiting;
+        m_rows[i].winner = static_cast<qint8>(winner);
+    }
+    emit dataChanged(index(m_exiting), index(m_rows.size() - 1), {AnimationPhaseRole, WinnerRole});
+    m_exiting = m_rows.size();
+
+    int generation = m_generation;
+    m_clock->after(EXIT_DURATION, GameClock::TableLane, this, [this, generation, count]() {
+        if (generation == m_generation) removeExited(count);
+    }, "removeExited");
+}
+
+void TrickModel::setTrick(const GameState& state) {
+    // Keep the rows that already match the trick
+    int live = m_rows.size() - m_exiting;
+    int same = 0;
+    while (same < live && same < state.trickSize &&
+           m_rows[m_exiting + same].card == state.trick[same] &&
+           m_rows[m_exiting + same].player == state.trickPlayer(same)) {
+        same++;
+    }
+
+    if (same < live) {
+        beginRemoveRows(QModelIndex(), m_exiting + same, m_rows.size() - 1);
+        m_rows.resize(m_exiting + same);
+        endRemoveRows();
+    }
+    for (int i = same; i < state.trickSize; ++i) {
+        append(state.trickPlayer(i), state.trick[i], Placed);
+    }
+}
+
+void TrickModel::clear() {
+    m_generation++;
+    if (m_rows.isEmpty()) return;
+
+    beginResetModel();
+    m_rows.clear();
+    m_exiting = 0;
+    endResetModel();
+}
+
+void TrickModel::append(int player, int card, AnimationPhase phase) {
+    Row row;
+    row.player = static_cast<quint8>(player);
+    row.card = static_cast<quint8>(card);
+    row.rotation = static_cast<qint8>(m_rotationEnabled ? QRandomGenerator::global()->bounded(11) - 5 : 0);
+    row.phase = static_cast<quint8>(phase);
+    row.winner = -1;
+
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size());
+    m_rows.append(row);
+    endInsertRows();
+}
+
+void TrickModel::removeExited(int count) {
+    count = qMin(count, m_exiting);
+    if (count == 0) return;
+
+    beginRemoveRows(QModelIndex(), 0, count - 1);
+    m_rows.remove(0, count);
+    m_exiting -= count;
+    endRemoveRows();
+}